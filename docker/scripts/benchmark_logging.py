@@ -0,0 +1,50 @@
+# SST configuration for benchmark_logging.sh: a Cinnamon system at verbose=0 with the analytical
+# memory model, so the run loop time is dominated by the element itself.
+#
+# sst --print-timing-info benchmark_logging.py -- --trace <file> [--num-chiplets N]
+# A trace containing {chiplet} is formatted with each chiplet's ID.
+import argparse
+
+import sst
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--trace", required=True)
+parser.add_argument("--num-chiplets", type=int, default=1)
+parser.add_argument("--clock", default="1GHz")
+args = parser.parse_args()
+
+cpu = sst.Component("cpu", "cinnamon.CPU")
+cpu.addParams({
+    "verbose": 0,
+    "clock": args.clock,
+    "num_chiplets": args.num_chiplets,
+    "progressInterval": 0,
+})
+
+network = cpu.setSubComponent("network", "cinnamon.Network")
+network.addParams({
+    "verbose": 0,
+    "linkBW": "64GB/s",
+})
+
+for chipletID in range(args.num_chiplets):
+    chiplet = cpu.setSubComponent("chiplet_{}".format(chipletID), "cinnamon.Chiplet")
+    chiplet.addParams({
+        "verbose": 0,
+        "registerSampleInterval": 0,
+        "stallSampleInterval": 0,
+    })
+
+    reader = chiplet.setSubComponent("reader", "cinnamon.CinnamonTextTraceReader")
+    reader.addParams({
+        "file": args.trace.format(chiplet=chipletID),
+    })
+
+    memory = chiplet.setSubComponent("memory", "cinnamon.SimpleHBM")
+    memory.addParams({
+        "verbose": 0,
+    })
+
+    link = sst.Link("network_link_{}".format(chipletID))
+    chiplet.addLink(link, "cinnamon_network_port", "1ns")
+    network.addLink(link, "chiplet_port_{}".format(chipletID), "1ns")
@@ -0,0 +1,49 @@
+#!/bin/bash
+# Simulator throughput with logging compiled out (CINNAMON_MAX_VERBOSE=0) and compiled in
+# (CINNAMON_MAX_VERBOSE=100), both running at verbose=0. Rebuilds and installs the element for each
+# configuration and restores the default afterwards.
+#
+# Usage: benchmark_logging.sh <trace> [runs] [num_chiplets]
+set -eou pipefail
+
+if [[ $# -lt 1 ]]; then
+    echo "Usage: $0 <trace> [runs] [num_chiplets]"
+    exit 1
+fi
+
+TRACE=$1
+RUNS=${2:-3}
+CHIPLETS=${3:-1}
+SCRIPT_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+BUILD_DIR=${BUILD_DIR:-/cinnamon_artifact/simulator/build}
+SST=${SST:-${BUILD_DIR}/install/sst-core/bin/sst}
+
+build() {
+    cmake -DCINNAMON_MAX_VERBOSE="$1" ${BUILD_DIR} > /dev/null
+    cmake --build ${BUILD_DIR} --target install > /dev/null
+}
+trap 'build ""' EXIT
+
+# Mean run loop time in seconds over RUNS runs
+benchmark() {
+    local total=0
+    for run in $(seq ${RUNS}); do
+        local seconds
+        seconds=$(${SST} --print-timing-info ${SCRIPT_DIR}/benchmark_logging.py -- --trace "${TRACE}" --num-chiplets ${CHIPLETS} \
+            | grep -i "run loop time" | grep -oE "[0-9]+(\.[0-9]+)?" | head -1)
+        echo "    run ${run}: ${seconds} s" >&2
+        total=$(python3 -c "print(${total} + ${seconds})")
+    done
+    python3 -c "print(${total} / ${RUNS})"
+}
+
+echo "Logging compiled out"
+build 0
+OFF=$(benchmark)
+echo "Logging compiled in"
+build 100
+ON=$(benchmark)
+
+printf "Run loop time, logging compiled out: %.3f s\n" ${OFF}
+printf "Run loop time, logging compiled in:  %.3f s\n" ${ON}
+printf "Slowdown with logging compiled in:   %.3fx\n" $(python3 -c "print(${ON} / ${OFF})")
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+# Convert a Cinnamon pipeline event log (CPU param eventLogFile) to Chrome trace JSON.
+# The output loads in ui.perfetto.dev or chrome://tracing. One process per chiplet,
+# one thread per track. Timestamps are in cycles.
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"CNMNEVT1"
+RECORD = struct.Struct("<QQQIHBB")
+
+TRACK, OPCODE, DISPATCH, OPERANDS_READY, RESERVE, COMPLETE, REGISTER_FREE, MEMORY, NETWORK = range(9)
+NO_TRACK = 0xFFFFFFFF
+NO_OPCODE = 0xFF
+
+SPANS = {DISPATCH: "dispatch", RESERVE: "execute", MEMORY: "memory", NETWORK: "network"}
+INSTANTS = {OPERANDS_READY: "operands ready", COMPLETE: "complete", REGISTER_FREE: "register free"}
+
+
+def read_records(path):
+    with open(path, "rb") as f:
+        if f.read(len(MAGIC)) != MAGIC:
+            sys.exit(f"{path}: not a Cinnamon event log")
+        while True:
+            raw = f.read(RECORD.size)
+            if len(raw) < RECORD.size:
+                return
+            begin, end, ident, track, chiplet, kind, opcode = RECORD.unpack(raw)
+            name = f.read(ident).decode() if kind in (TRACK, OPCODE) else None
+            yield begin, end, ident, track, chiplet, kind, opcode, name
+
+
+def convert(path, start, stop):
+    opcodes = {}
+    events = []
+    chiplets = set()
+    for begin, end, ident, track, chiplet, kind, opcode, name in read_records(path):
+        if kind == OPCODE:
+            opcodes[opcode] = name
+            continue
+        if kind == TRACK:
+            chiplets.add(chiplet)
+            events.append({"ph": "M", "name": "thread_name", "pid": chiplet, "tid": track, "args": {"name": name}})
+            continue
+        if end < start or (stop is not None and begin >= stop):
+            continue
+        label = opcodes.get(opcode, "") if opcode != NO_OPCODE else ""
+        tid = track if track != NO_TRACK else 0
+        if kind in SPANS:
+            events.append({"ph": "X", "name": label or SPANS[kind], "cat": SPANS[kind], "pid": chiplet, "tid": tid,
+                           "ts": begin, "dur": max(end - begin, 1), "args": {"id": ident}})
+        elif kind in INSTANTS:
+            what = INSTANTS[kind]
+            events.append({"ph": "i", "s": "t", "name": f"{what} {label}".strip() if kind != REGISTER_FREE else f"{what} v{ident}",
+                           "cat": what, "pid": chiplet, "tid": tid, "ts": begin, "args": {"id": ident}})
+    for chiplet in sorted(chiplets):
+        events.append({"ph": "M", "name": "process_name", "pid": chiplet, "args": {"name": f"chiplet_{chiplet}"}})
+    return {"traceEvents": events, "displayTimeUnit": "ns", "otherData": {"timeUnit": "cycles"}}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a Cinnamon event log to Chrome trace JSON")
+    parser.add_argument("log", help="binary event log written by the simulator")
+    parser.add_argument("-o", "--output", default="-", help="JSON output file (default: stdout)")
+    parser.add_argument("--start", type=int, default=0, help="drop events that end before this cycle")
+    parser.add_argument("--stop", type=int, default=None, help="drop events that begin at or after this cycle")
+    args = parser.parse_args()
+
+    trace = convert(args.log, args.start, args.stop)
+    if args.output == "-":
+        json.dump(trace, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,5 +1,10 @@
 #include <queue>
 #include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <limits>
+#include <optional>
 
 #include "sst/core/component.h"
 #include "sst/core/event.h"
@@ -12,6 +17,7 @@
 
 #include "readers/reader.h"
 #include "CPU.h"
+#include "utils/log.h"
 #include "utils/utils.h"
 
 // using namespace SST;
@@ -33,11 +39,20 @@ CinnamonCPU::CinnamonCPU(ComponentId_t id, Params &params) : Component(id) {
     TimeConverter *time = registerClock(prosClock, new Clock::Handler<CinnamonCPU>(this, &CinnamonCPU::tick));
 
     numChiplets = params.find<size_t>("num_chiplets", "1");
+    validateMemoryModel = params.find<bool>("validateMemoryModel", false);
+    if(validateMemoryModel && numChiplets != 2) {
+        output->fatal(CALL_INFO, -1, "validateMemoryModel requires num_chiplets = 2, got %zu\n", numChiplets);
+    }
 
     VEC_DEPTH = params.find<uint64_t>("vec_depth", "64");
+    watchdogCycles = params.find<SST::Cycle_t>("watchdogCycles", 1000000);
+    progressInterval = params.find<double>("progressInterval", 60);
+    progressFile = params.find<std::string>("progressFile", "");
+    networkEnergyPerByte = params.find<double>("networkEnergyPerByte", 0);
+    networkStaticPower = params.find<double>("networkStaticPower", 0);
 
-    output->verbose(CALL_INFO, 1, 0, "Configured Cinnamon VecDepth %lu\n",VEC_DEPTH); 
-    output->verbose(CALL_INFO, 1, 0, "Configured Cinnamon clock for %s\n", prosClock.c_str());
+    CINNAMON_VERBOSE(output, 1, 0, "Configured Cinnamon VecDepth %lu\n",VEC_DEPTH); 
+    CINNAMON_VERBOSE(output, 1, 0, "Configured Cinnamon clock for %s\n", prosClock.c_str());
 
     // // tell the simulator not to end without us
     registerAsPrimaryComponent();
@@ -67,6 +82,48 @@ CinnamonCPU::CinnamonCPU(ComponentId_t id, Params &params) : Component(id) {
     //     output->fatal(CALL_INFO, -1, "Unable to load memoryInterface subcomponent\n");
     // }
 
+    auto eventLogFile = params.find<std::string>("eventLogFile", "");
+    if(!eventLogFile.empty()) {
+        auto eventLogStart = params.find<Cycle_t>("eventLogStart", 0);
+        auto eventLogStop = params.find<Cycle_t>("eventLogStop", 0);
+        if(eventLogStop == 0) {
+            eventLogStop = std::numeric_limits<Cycle_t>::max();
+        }
+        eventLog_ = std::make_unique<CinnamonEventLog>(eventLogFile, eventLogStart, eventLogStop, output);
+        CINNAMON_VERBOSE(output, 1, 0, "Writing pipeline event log to %s\n", eventLogFile.c_str());
+    }
+
+    auto stallTraceFile = params.find<std::string>("stallTraceFile", "");
+    if(!stallTraceFile.empty()) {
+        stallTrace_.open(stallTraceFile, std::ios::trunc);
+        if(!stallTrace_.is_open()) {
+            output->fatal(CALL_INFO, -1, "Unable to open stallTraceFile: %s\n", stallTraceFile.c_str());
+        }
+        stallTrace_ << CinnamonStallStack::csvHeader() << "\n";
+    }
+
+    auto termTrafficFile = params.find<std::string>("termTrafficFile", "");
+    if(!termTrafficFile.empty()) {
+        termTraffic_.open(termTrafficFile, std::ios::trunc);
+        if(!termTraffic_.is_open()) {
+            output->fatal(CALL_INFO, -1, "Unable to open termTrafficFile: %s\n", termTrafficFile.c_str());
+        }
+        termTraffic_ << CinnamonTermTraffic::csvHeader() << "\n";
+    }
+
+    auto powerTraceFile = params.find<std::string>("powerTraceFile", "");
+    if(!powerTraceFile.empty()) {
+        powerSampleInterval = params.find<Cycle_t>("powerSampleInterval", 100000);
+        if(powerSampleInterval == 0) {
+            output->fatal(CALL_INFO, -1, "powerSampleInterval must be non-zero with a powerTraceFile\n");
+        }
+        powerTrace_.open(powerTraceFile, std::ios::trunc);
+        if(!powerTrace_.is_open()) {
+            output->fatal(CALL_INFO, -1, "Unable to open powerTraceFile: %s\n", powerTraceFile.c_str());
+        }
+        powerTrace_ << "cycle,time_ns,component,dynamic_mw,static_mw,total_mw\n";
+    }
+
     network.reset(loadUserSubComponent<CinnamonNetwork>("network", ComponentInfo::SHARE_NONE,this,numChiplets));
     if (!network) {
         output->fatal(CALL_INFO, -1, "Unable to load Cinnamon Network\n");
@@ -80,7 +137,23 @@ CinnamonCPU::CinnamonCPU(ComponentId_t id, Params &params) : Component(id) {
         chiplets.push_back(std::move(chiplet));
     }
 
-    output->verbose(CALL_INFO, 1, 0, "Cinnamon configuration completed successfully.\n");
+    if(validateMemoryModel) {
+        auto referenceTrace = chiplets[0]->traceName();
+        auto analyticalTrace = chiplets[1]->traceName();
+        std::error_code ec;
+        if(referenceTrace.empty() || !std::filesystem::equivalent(referenceTrace, analyticalTrace, ec)) {
+            output->fatal(CALL_INFO, -1, "validateMemoryModel requires chiplet_0 and chiplet_1 to read the same trace, got '%s' and '%s'\n",
+                          referenceTrace.c_str(), analyticalTrace.c_str());
+        }
+        if(chiplets[0]->usesSimpleHBM()) {
+            output->fatal(CALL_INFO, -1, "validateMemoryModel requires chiplet_0 to use the reference memory, not cinnamon.SimpleHBM\n");
+        }
+        if(!chiplets[1]->usesSimpleHBM()) {
+            output->fatal(CALL_INFO, -1, "validateMemoryModel requires every memory slot of chiplet_1 to be cinnamon.SimpleHBM\n");
+        }
+    }
+
+    CINNAMON_VERBOSE(output, 1, 0, "Cinnamon configuration completed successfully.\n");
 }
 
 void CinnamonCPU::init(unsigned int phase) {
@@ -93,30 +166,281 @@ void CinnamonCPU::setup() {
     for(auto & chiplet: chiplets){
         chiplet->setup();
     }
+    progressStart = std::chrono::steady_clock::now();
+    lastProgressReport.time = progressStart;
+    lastProgressReport.instructions.assign(chiplets.size(), 0);
+    lastPowerSample.dynamicEnergy.assign(chiplets.size() + 1, 0);
 }
 
 void CinnamonCPU::finish() {
+    if(progressInterval > 0) {
+        reportProgress(lastCycle, true);
+    }
     for(auto & chiplet: chiplets){
         chiplet->finish();
     }
+    if(eventLog_) {
+        eventLog_->flush();
+    }
+    if(stallTrace_.is_open()) {
+        stallTrace_.close();
+    }
+    if(termTraffic_.is_open()) {
+        termTraffic_.close();
+    }
+    if(powerTrace_.is_open()) {
+        samplePower(lastCycle);
+        powerTrace_.close();
+    }
+    CinnamonOpcodeStats opcodeStats;
+    for(auto & chiplet: chiplets){
+        opcodeStats.merge(chiplet->opcodeStats());
+    }
+	output->output("------------------------------------------------------------------------\n");
+	output->output("%s",opcodeStats.printStats("System Opcodes", true).c_str());
 	output->output("------------------------------------------------------------------------\n");
 	output->output("%s",network->printStats().c_str());
 	output->output("------------------------------------------------------------------------\n");
+    auto energy = printEnergy();
+    if(!energy.empty()) {
+        output->output("%s",energy.c_str());
+        output->output("------------------------------------------------------------------------\n");
+    }
+    if(validateMemoryModel) {
+        // chiplet_0 runs against the reference memory model, chiplet_1 against the analytical model
+        SST::Cycle_t reference = chiplets[0]->completedAtCycle.value_or(0);
+        SST::Cycle_t analytical = chiplets[1]->completedAtCycle.value_or(0);
+        int64_t delta = int64_t(analytical) - int64_t(reference);
+        double deltaPercent = reference ? (100.0 * delta) / reference : 0.0;
+        output->output("Memory Model Validation:\n");
+        output->output("\tReference Cycles: %" PRIu64 "\n", reference);
+        output->output("\tAnalytical Cycles: %" PRIu64 "\n", analytical);
+        output->output("\tDelta: %" PRId64 " cycles (%.2f%%)\n", delta, deltaPercent);
+        output->output("------------------------------------------------------------------------\n");
+    }
 	output->output("Finished \n");
 }
 
 bool CinnamonCPU::tick(SST::Cycle_t cycle) {
     bool retval = true;
+    lastCycle = cycle;
+    // Only look at the wall clock every 1024 cycles
+    if(progressInterval > 0 && (cycle & 1023) == 0 &&
+       std::chrono::duration<double>(std::chrono::steady_clock::now() - lastProgressReport.time).count() >= progressInterval) {
+        reportProgress(cycle, false);
+    }
     for(auto &chiplet: chiplets){
         retval &= chiplet->tick(cycle);
     }
     network->tick(cycle);
+    if(powerTrace_.is_open() && cycle % powerSampleInterval == 0) {
+        samplePower(cycle);
+    }
     if(retval){
         primaryComponentOKToEndSim();
         return true;
     }
+    if(watchdogCycles) {
+        checkWatchdog(cycle);
+    }
     return false;
 }
 
+// Registers that are never freed or syncs that never become ready leave the clock ticking forever.
+// Terminate with the state of every chiplet and the network once nothing has moved for watchdogCycles
+void CinnamonCPU::checkWatchdog(Cycle_t cycle) {
+    uint64_t progress = network->progress();
+    for(auto & chiplet: chiplets){
+        progress += chiplet->progress();
+    }
+    if(progress != lastProgress) {
+        lastProgress = progress;
+        lastProgressCycle = cycle;
+        return;
+    }
+    if(cycle - lastProgressCycle < watchdogCycles) {
+        return;
+    }
+    output->output("------------------------------------------------------------------------\n");
+    output->output("Watchdog: no progress since cycle %" PRIu64 "\n", lastProgressCycle);
+    for(auto & chiplet: chiplets){
+        output->output("------------------------------------------------------------------------\n");
+        output->output("%s", chiplet->dumpState().c_str());
+    }
+    output->output("------------------------------------------------------------------------\n");
+    output->output("%s", network->dumpState().c_str());
+    output->output("------------------------------------------------------------------------\n");
+    output->fatal(CALL_INFO, -1, "Deadlock: no dispatch, issue, completion or network progress for %" PRIu64 " cycles (cycle %" PRIu64 ")\n",
+                  watchdogCycles, cycle);
+}
+
+// One row per chiplet, one for the network and one for the system. Dynamic power is the energy of the
+// interval over its length, in pJ per ns
+void CinnamonCPU::samplePower(Cycle_t cycle) {
+    uint64_t nanoSeconds = getCurrentSimTimeNano();
+    if(nanoSeconds == lastPowerSample.nanoSeconds) {
+        return;
+    }
+    double interval = nanoSeconds - lastPowerSample.nanoSeconds;
+    double systemDynamic = 0;
+    double systemStatic = 0;
+    auto row = [&](const std::string & component, double dynamicEnergy, double staticPower, double & lastEnergy) {
+        double dynamicPower = (dynamicEnergy - lastEnergy) / interval;
+        lastEnergy = dynamicEnergy;
+        systemDynamic += dynamicPower;
+        systemStatic += staticPower;
+        powerTrace_ << cycle << "," << nanoSeconds << "," << component << "," << dynamicPower << ","
+                    << staticPower << "," << dynamicPower + staticPower << "\n";
+    };
+    for(size_t i = 0; i < chiplets.size(); i++){
+        auto activity = chiplets[i]->activity();
+        auto & model = chiplets[i]->energyModel();
+        row(std::to_string(i), model.dynamicEnergy(activity).dynamic(), model.staticPower(activity), lastPowerSample.dynamicEnergy[i]);
+    }
+    row("network", networkEnergyPerByte * network->bytesMoved(), networkStaticPower * chiplets.size(), lastPowerSample.dynamicEnergy.back());
+    powerTrace_ << cycle << "," << nanoSeconds << ",system," << systemDynamic << "," << systemStatic << ","
+                << systemDynamic + systemStatic << "\n";
+    lastPowerSample.nanoSeconds = nanoSeconds;
+}
+
+// Total energy of every chiplet and the network over the whole simulated time. Empty unless some
+// energy coefficient is set
+std::string CinnamonCPU::printEnergy() const {
+    bool configured = networkEnergyPerByte != 0 || networkStaticPower != 0;
+    for(auto & chiplet: chiplets){
+        configured |= chiplet->energyModel().configured();
+    }
+    if(!configured) {
+        return "";
+    }
+    uint64_t nanoSeconds = getCurrentSimTimeNano();
+    double total = 0;
+    std::stringstream s;
+    s << std::fixed << std::setprecision(3);
+    s << "System Energy:\n";
+    for(size_t i = 0; i < chiplets.size(); i++){
+        auto activity = chiplets[i]->activity();
+        auto & model = chiplets[i]->energyModel();
+        double energy = model.dynamicEnergy(activity).dynamic() + model.staticPower(activity) * nanoSeconds;
+        total += energy;
+        s << "\tChiplet " << i << ": " << energy / 1e6 << " uJ\n";
+    }
+    double networkEnergy = networkEnergyPerByte * network->bytesMoved() + networkStaticPower * chiplets.size() * nanoSeconds;
+    total += networkEnergy;
+    s << "\tNetwork: " << networkEnergy / 1e6 << " uJ (" << network->bytesMoved() << " bytes)\n";
+    s << "\tTotal Energy: " << total / 1e6 << " uJ\n";
+    s << "\tAverage Power: " << (nanoSeconds ? total / nanoSeconds : 0.0) << " mW\n";
+    return s.str();
+}
+
+// One line per progressInterval instead of per-chiplet heartbeats. The trace fraction is the share of
+// trace bytes the readers have consumed and drives the ETA. IPC is over the last interval
+void CinnamonCPU::reportProgress(Cycle_t cycle, bool done) {
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - progressStart).count();
+    double interval = std::chrono::duration<double>(now - lastProgressReport.time).count();
+    Cycle_t cycles = cycle - lastProgressReport.cycle;
+
+    uint64_t traceBytes = 0;
+    uint64_t traceBytesRead = 0;
+    uint64_t instructions = 0;
+    uint64_t intervalInstructions = 0;
+    size_t completed = 0;
+    std::vector<double> ipc;
+    for(size_t i = 0; i < chiplets.size(); i++){
+        auto & chiplet = chiplets[i];
+        traceBytes += chiplet->traceBytes();
+        traceBytesRead += std::min(chiplet->traceBytesRead(), chiplet->traceBytes());
+        auto fetched = chiplet->instructionsFetched();
+        instructions += fetched;
+        intervalInstructions += fetched - lastProgressReport.instructions[i];
+        ipc.push_back(cycles ? static_cast<double>(fetched - lastProgressReport.instructions[i]) / cycles : 0.0);
+        lastProgressReport.instructions[i] = fetched;
+        completed += chiplet->completed();
+    }
+    lastProgressReport.time = now;
+    lastProgressReport.cycle = cycle;
+
+    std::optional<double> fraction;
+    if(done) {
+        fraction = 1.0;
+    } else if(traceBytes > 0) {
+        fraction = static_cast<double>(traceBytesRead) / traceBytes;
+    }
+    std::optional<double> eta;
+    if(fraction.has_value() && fraction.value() > 0) {
+        eta = elapsed * (1.0 - fraction.value()) / fraction.value();
+    }
+    double cyclesPerSecond = interval > 0 ? cycles / interval : 0.0;
+    double instructionsPerSecond = interval > 0 ? intervalInstructions / interval : 0.0;
+
+    std::stringstream s;
+    s << std::setprecision(3) << "Progress: ";
+    if(fraction.has_value()) {
+        s << std::fixed << std::setprecision(1) << 100.0 * fraction.value() << "% of trace" << std::defaultfloat << std::setprecision(3);
+    } else {
+        s << "trace size unknown";
+    }
+    s << ", cycle " << cycle << ", " << instructions << " instructions, "
+      << cyclesPerSecond << " cycles/s, " << instructionsPerSecond << " instructions/s, IPC";
+    for(size_t i = 0; i < chiplets.size(); i++){
+        s << " ";
+        if(chiplets[i]->completed()) {
+            s << "done";
+        } else {
+            s << ipc[i];
+        }
+    }
+    s << ", ETA ";
+    if(done) {
+        s << "0:00:00";
+    } else if(eta.has_value()) {
+        uint64_t seconds = eta.value();
+        s << seconds / 3600 << ":" << std::setfill('0') << std::setw(2) << (seconds / 60) % 60 << ":" << std::setw(2) << seconds % 60;
+    } else {
+        s << "unknown";
+    }
+    output->output("%s\n", s.str().c_str());
+    output->flush();
+
+    if(progressFile.empty()) {
+        return;
+    }
+    // Write a new file and rename it over the old one, so readers never see a partial file
+    std::string tmpFile = progressFile + ".tmp";
+    std::ofstream file(tmpFile, std::ios::trunc);
+    if(!file.is_open()) {
+        output->fatal(CALL_INFO, -1, "Unable to open progressFile: %s\n", tmpFile.c_str());
+    }
+    file << std::setprecision(6);
+    file << "{\"done\": " << (done ? "true" : "false")
+         << ", \"cycle\": " << cycle
+         << ", \"elapsed_seconds\": " << elapsed
+         << ", \"trace_fraction\": ";
+    if(fraction.has_value()) {
+        file << fraction.value();
+    } else {
+        file << "null";
+    }
+    file << ", \"instructions\": " << instructions
+         << ", \"cycles_per_second\": " << cyclesPerSecond
+         << ", \"instructions_per_second\": " << instructionsPerSecond
+         << ", \"eta_seconds\": ";
+    if(eta.has_value()) {
+        file << eta.value();
+    } else {
+        file << "null";
+    }
+    file << ", \"chiplets_completed\": " << completed << ", \"ipc\": [";
+    for(size_t i = 0; i < ipc.size(); i++){
+        file << (i ? ", " : "") << ipc[i];
+    }
+    file << "]}\n";
+    file.close();
+    if(std::rename(tmpFile.c_str(), progressFile.c_str()) != 0) {
+        output->fatal(CALL_INFO, -1, "Unable to write progressFile: %s\n", progressFile.c_str());
+    }
+}
+
 } // Namespace Cinnamon
 } // Namespace SST
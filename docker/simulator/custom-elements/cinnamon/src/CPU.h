@@ -2,6 +2,8 @@
 #define CINNAMONCPU_H
 
 #include <queue>
+#include <chrono>
+#include <fstream>
 
 #include "sst/core/output.h"
 #include "sst/core/component.h"
@@ -17,6 +19,7 @@
 #include "chiplet.h"
 #include "network.h"
 #include "latency.h"
+#include "eventLog.h"
 
 
 // using namespace SST;
@@ -73,6 +76,33 @@ public:
       {"numPhysicalVecRegs", "Sets number of physical vector registers", "10"},
       {"vecRegSize", "Sets size of a vector register", "10"},
 
+      // Memory model validation
+      {"validateMemoryModel", "Compare completion cycles of chiplet_0 (reference memory) and chiplet_1 (cinnamon.SimpleHBM) running the same trace", "false"},
+
+      // Pipeline event log
+      {"eventLogFile", "Binary pipeline event log. Convert with scripts/cinnamon_timeline.py. Empty disables the log", ""},
+      {"eventLogStart", "First cycle recorded in the event log", "0"},
+      {"eventLogStop", "Cycle at which the event log stops recording. 0 records until the end", "0"},
+
+      // Stall attribution
+      {"stallTraceFile", "CSV time series of per-chiplet dispatch and issue stall cycles, one row per chiplet stallSampleInterval. Empty disables the file", ""},
+
+      // Deadlock watchdog
+      {"watchdogCycles", "Cycles without any dispatch, issue, completion or network progress after which the simulation dumps its state and terminates. 0 disables the watchdog", "1000000"},
+
+      // Progress reporting
+      {"progressInterval", "Wall-clock seconds between progress lines with trace fraction, simulation rate, per-chiplet IPC and ETA. 0 disables the report", "60"},
+      {"progressFile", "JSON file rewritten with every progress line, for batch schedulers to poll. Empty disables the file", ""},
+
+      // Memory traffic
+      {"termTrafficFile", "CSV of per-term memory traffic and reuse distance for every chiplet, written at the end of simulation. Empty disables the file", ""},
+
+      // Energy and power. Per unit coefficients are chiplet parameters
+      {"networkEnergyPerByte", "pJ per byte a chiplet sends into the network or the network delivers to a chiplet", "0"},
+      {"networkStaticPower", "Static power in mW of each chiplet's network port", "0"},
+      {"powerTraceFile", "CSV time series of dynamic and static power of every chiplet, the network and the system, one row each per powerSampleInterval. Empty disables the file", ""},
+      {"powerSampleInterval", "Cycles between rows of the power time series", "100000"},
+
       //
 
       //
@@ -94,6 +124,21 @@ public:
     return latency_;
   }
 
+  // nullptr unless eventLogFile is set
+  CinnamonEventLog * eventLog() {
+    return eventLog_.get();
+  }
+
+  // nullptr unless stallTraceFile is set
+  std::ofstream * stallTrace() {
+    return stallTrace_.is_open() ? &stallTrace_ : nullptr;
+  }
+
+  // nullptr unless termTrafficFile is set
+  std::ofstream * termTraffic() {
+    return termTraffic_.is_open() ? &termTraffic_ : nullptr;
+  }
+
 private:
   CinnamonCPU();                       // Serialization only
   CinnamonCPU(const CinnamonCPU &);       // Do not impl.
@@ -105,20 +150,39 @@ private:
 
   std::unique_ptr<CinnamonNetwork> network;
   Latency latency_;
-
-  Cycle_t networkBusyCycles = 0;
+  bool validateMemoryModel = false;
+  std::unique_ptr<CinnamonEventLog> eventLog_;
+  std::ofstream stallTrace_;
+  std::ofstream termTraffic_;
+
+  SST::Cycle_t watchdogCycles = 1000000;
+  SST::Cycle_t lastProgressCycle = 0;
+  uint64_t lastProgress = 0;
+  void checkWatchdog(Cycle_t cycle);
+
+  double progressInterval = 60; // Wall-clock seconds
+  std::string progressFile;
+  Cycle_t lastCycle = 0;
+  std::chrono::steady_clock::time_point progressStart;
+  struct ProgressSample {
+      std::chrono::steady_clock::time_point time;
+      Cycle_t cycle = 0;
+      std::vector<uint64_t> instructions; // Indexed by chiplet
+  } lastProgressReport;
+  void reportProgress(Cycle_t cycle, bool done);
+
+  double networkEnergyPerByte = 0; // pJ
+  double networkStaticPower = 0;   // mW per chiplet port
+  std::ofstream powerTrace_;
+  Cycle_t powerSampleInterval = 100000;
+  struct PowerSample {
+      uint64_t nanoSeconds = 0;
+      std::vector<double> dynamicEnergy; // pJ, indexed by chiplet with the network last
+  } lastPowerSample;
+  void samplePower(Cycle_t cycle);
+  std::string printEnergy() const;
 
   bool tick(Cycle_t cycle);
-
-  void networkBusyCycle(Cycle_t currentCycle, Cycle_t val){
-    networkBusyCycles += val;
-    if(currentCycle % 100000) {
-
-      networkBusyCycles = 0;
-
-    }
-
-  }
 };
 
 } // Namespace Cinnamon
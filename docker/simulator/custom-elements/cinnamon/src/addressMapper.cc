@@ -0,0 +1,154 @@
+#include "sst/core/sst_config.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "addressMapper.h"
+#include "utils/log.h"
+
+namespace SST {
+namespace Cinnamon {
+
+CinnamonAddressMapper::CinnamonAddressMapper(const Params & params, std::shared_ptr<SST::Output> output, std::size_t limbSize) : output(output), limbSize_(limbSize) {
+
+    auto policyString = params.find<std::string>("addressMapPolicy", "contiguous");
+    if(policyString == "contiguous") {
+        policy_ = Policy::Contiguous;
+    } else if(policyString == "limbStriped") {
+        policy_ = Policy::LimbStriped;
+    } else if(policyString == "termClass") {
+        policy_ = Policy::TermClass;
+    } else if(policyString == "xorHash") {
+        policy_ = Policy::XorHash;
+    } else {
+        output->fatal(CALL_INFO, -1, "Unknown addressMapPolicy: %s\n", policyString.c_str());
+    }
+
+    numChannels_ = params.find<std::size_t>("numMemChannels", 1);
+    interleaveSize = params.find<std::size_t>("channelInterleaveSize", 256);
+    keyChannels = params.find<std::size_t>("keyChannels", numChannels_ / 2);
+    params.find_array<std::string>("keyTermPrefixes", keyTermPrefixes);
+
+    if(numChannels_ == 0 || interleaveSize == 0) {
+        output->fatal(CALL_INFO, -1, "numMemChannels and channelInterleaveSize must be non-zero\n");
+    }
+    if(policy_ == Policy::XorHash && (numChannels_ & (numChannels_ - 1)) != 0) {
+        output->fatal(CALL_INFO, -1, "xorHash address mapping requires a power-of-two numMemChannels, got %zu\n", numChannels_);
+    }
+    if(policy_ == Policy::TermClass && (keyChannels == 0 || keyChannels >= numChannels_)) {
+        output->fatal(CALL_INFO, -1, "termClass address mapping requires 0 < keyChannels < numMemChannels, got %zu of %zu\n", keyChannels, numChannels_);
+    }
+
+    CINNAMON_VERBOSE(output, 1, 0, "Address Map Policy: %s, Channels: %zu, Interleave: %zu B\n",
+                getPolicyString(policy_).c_str(), numChannels_, interleaveSize);
+}
+
+void CinnamonAddressMapper::markKeyTerm(const std::string & term) {
+    keyTerms.insert(term);
+}
+
+CinnamonAddressMapper::TermClass CinnamonAddressMapper::termClass(const std::string & term) const {
+    if(keyTerms.find(term) != keyTerms.end()) {
+        return TermClass::Key;
+    }
+    for(auto & prefix: keyTermPrefixes) {
+        if(term.compare(0, prefix.size(), prefix) == 0) {
+            return TermClass::Key;
+        }
+    }
+    return TermClass::Ciphertext;
+}
+
+CinnamonAddressMapper::TermClass CinnamonAddressMapper::termClass(Addr addr) const {
+    return termInfo.at(addr / limbSize_).termClass;
+}
+
+CinnamonAddressMapper::Addr CinnamonAddressMapper::mapTerm(const std::string & term) {
+    auto it = termToAddressMap.find(term);
+    if(it != termToAddressMap.end()) {
+        return it->second;
+    }
+    Addr addr = termInfo.size();
+    addr *= limbSize_;
+    auto tClass = termClass(term);
+    auto & classCount = numClassTerms[static_cast<int>(tClass)];
+    termInfo.push_back({tClass, classCount});
+    classCount++;
+    termToAddressMap[term] = addr;
+    return addr;
+}
+
+CinnamonAddressMapper::Addr CinnamonAddressMapper::translate(Addr addr) const {
+    if(policy_ == Policy::Contiguous || numChannels_ == 1) {
+        return addr;
+    }
+
+    uint64_t termIndex = addr / limbSize_;
+    Addr offset = addr % limbSize_;
+    uint64_t chunk = offset / interleaveSize;
+
+    switch(policy_) {
+        case Policy::LimbStriped: {
+            uint64_t rowsPerLimb = (limbSize_ + interleaveSize * numChannels_ - 1) / (interleaveSize * numChannels_);
+            uint64_t row = termIndex * rowsPerLimb + chunk / numChannels_;
+            std::size_t ch = (chunk + termIndex) % numChannels_;
+            return stripe(row, ch, offset);
+        }
+        case Policy::TermClass: {
+            auto & info = termInfo.at(termIndex);
+            std::size_t groupBase = (info.termClass == TermClass::Key) ? 0 : keyChannels;
+            std::size_t groupSize = (info.termClass == TermClass::Key) ? keyChannels : numChannels_ - keyChannels;
+            uint64_t rowsPerLimb = (limbSize_ + interleaveSize * groupSize - 1) / (interleaveSize * groupSize);
+            uint64_t row = info.classIndex * rowsPerLimb + chunk / groupSize;
+            std::size_t ch = groupBase + chunk % groupSize;
+            return stripe(row, ch, offset);
+        }
+        case Policy::XorHash: {
+            uint64_t globalChunk = addr / interleaveSize;
+            uint64_t row = globalChunk / numChannels_;
+            uint64_t hash = 0;
+            for(uint64_t r = row; r != 0; r /= numChannels_) {
+                hash ^= r % numChannels_;
+            }
+            std::size_t ch = (globalChunk % numChannels_) ^ hash;
+            return stripe(row, ch, addr);
+        }
+        default:
+            assert(0 && "Unhandled address map policy");
+    }
+    return addr;
+}
+
+std::size_t CinnamonAddressMapper::channel(Addr physAddr) const {
+    return (physAddr / interleaveSize) % numChannels_;
+}
+
+std::size_t CinnamonAddressMapper::contiguousBytes(Addr addr) const {
+    if(numChannels_ == 1) {
+        return std::numeric_limits<std::size_t>::max();
+    }
+    if(policy_ == Policy::LimbStriped || policy_ == Policy::TermClass) {
+        // Chunks are counted from the start of each limb
+        Addr offset = addr % limbSize_;
+        return std::min<std::size_t>(interleaveSize - offset % interleaveSize, limbSize_ - offset);
+    }
+    return interleaveSize - addr % interleaveSize;
+}
+
+std::string CinnamonAddressMapper::getPolicyString(Policy policy) {
+    switch(policy) {
+        case Policy::Contiguous:
+            return "contiguous";
+        case Policy::LimbStriped:
+            return "limbStriped";
+        case Policy::TermClass:
+            return "termClass";
+        case Policy::XorHash:
+            return "xorHash";
+        default:
+            return "unknown";
+    }
+}
+
+} // Namespace Cinnamon
+} // Namespace SST
@@ -0,0 +1,102 @@
+#ifndef _H_SST_CINNAMON_ADDRESS_MAPPER
+#define _H_SST_CINNAMON_ADDRESS_MAPPER
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "sst/core/output.h"
+#include "sst/core/params.h"
+#include "sst/core/interfaces/stdMem.h"
+
+namespace SST {
+namespace Cinnamon {
+
+// Maps trace terms to memory addresses and spreads them across HBM channels.
+//
+// Terms get a logical address (termIndex * limbSize) in first-touch order.
+// This is the address that the memory unit uses for aliasing. Each request is
+// translated to a physical address before it is sent to memory. The physical
+// channel of an address is (addr / interleaveSize) % numChannels, which
+// matches memHierarchy memory controllers configured with
+// interleave_size = channelInterleaveSize and
+// interleave_step = numMemChannels * channelInterleaveSize.
+class CinnamonAddressMapper {
+public:
+    using Addr = SST::Interfaces::StandardMem::Addr;
+
+    enum class Policy {
+        Contiguous,  // Physical == logical. Channel balance is left to memHierarchy
+        LimbStriped, // Each limb is striped over all channels, starting channel rotated per limb
+        TermClass,   // Keys and ciphertexts are striped over disjoint channel groups
+        XorHash      // Channel bits are XORed with the row bits to break power-of-two strides
+    };
+
+    enum class TermClass {
+        Ciphertext,
+        Key
+    };
+
+    CinnamonAddressMapper(const Params & params, std::shared_ptr<SST::Output> output, std::size_t limbSize);
+
+    // Returns the logical address of a term, allocating one on first touch
+    Addr mapTerm(const std::string & term);
+    // Record that a term holds key material (e.g. evkGen turned into a load)
+    void markKeyTerm(const std::string & term);
+    TermClass termClass(const std::string & term) const;
+    TermClass termClass(Addr addr) const;
+
+    Addr translate(Addr addr) const;
+    std::size_t channel(Addr physAddr) const;
+    // Bytes from addr that translate to one interleave chunk. Requests are split at this size so each
+    // piece goes to a single channel
+    std::size_t contiguousBytes(Addr addr) const;
+
+    std::size_t numChannels() const {
+        return numChannels_;
+    }
+
+    std::size_t numTerms() const {
+        return termToAddressMap.size();
+    }
+
+    std::size_t limbSize() const {
+        return limbSize_;
+    }
+
+    Policy policy() const {
+        return policy_;
+    }
+
+    static std::string getPolicyString(Policy policy);
+
+private:
+    std::shared_ptr<SST::Output> output;
+    Policy policy_ = Policy::Contiguous;
+    std::size_t limbSize_;
+    std::size_t numChannels_ = 1;
+    std::size_t interleaveSize = 256;
+    std::size_t keyChannels = 0;
+
+    std::vector<std::string> keyTermPrefixes;
+    std::set<std::string> keyTerms;
+
+    struct TermInfo {
+        TermClass termClass;
+        uint64_t classIndex; // Index of the term among terms of the same class
+    };
+
+    std::map<std::string,Addr> termToAddressMap;
+    std::vector<TermInfo> termInfo; // Indexed by logical address / limbSize
+    uint64_t numClassTerms[2] = {0, 0};
+
+    Addr stripe(uint64_t row, std::size_t channel, Addr offset) const {
+        return (row * numChannels_ + channel) * interleaveSize + (offset % interleaveSize);
+    }
+};
+
+} // Namespace Cinnamon
+} // Namespace SST
+
+#endif // _H_SST_CINNAMON_ADDRESS_MAPPER
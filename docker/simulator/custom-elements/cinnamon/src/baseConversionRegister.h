@@ -6,6 +6,8 @@
 #include <sstream>
 #include <string>
 
+#include "stallStack.h"
+
 
 namespace SST {
 namespace Cinnamon{
@@ -30,6 +32,12 @@ public:
     BaseConversionRegister(CinnamonChiplet *pe, const VirtualID_t virtID) : pe(pe), virtID(virtID), readsRemaining(0), writesRemaining(0), valueReady(false), references(0){};
     void setValueReady(bool b) { valueReady = b; }
     bool getValueReady() const { return valueReady; }
+    std::optional<CinnamonStallStack::Producer> blockingProducer() const {
+        if (valueReady) {
+            return std::nullopt;
+        }
+        return CinnamonStallStack::Producer::BaseConversion;
+    }
     VirtualID_t getVirtID() const { return virtID; }
     PhysicalID_t getPhyID() const { return phyID.value(); }
 
@@ -3,8 +3,10 @@
 
 #include "chiplet.h"
 #include "memoryUnit.h"
+#include "addressMapper.h"
 #include "functionalUnit.h"
 #include "CPU.h"
+#include "utils/log.h"
 #include <algorithm>
 
 
@@ -15,7 +17,7 @@ namespace Cinnamon {
  * 
  * Read and initialize simulator parameters (e.g. clock speed) from setting file (trace-*.py)
  */
-CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU * cpu, CinnamonNetwork * network, uint32_t chipletID): cpu(cpu), network(network) , chipletID_(chipletID), numInstructions(0), SubComponent(id) {
+CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU * cpu, CinnamonNetwork * network, uint32_t chipletID): SubComponent(id), numInstructions(0), energy_(params), cpu(cpu), chipletID_(chipletID), network(network) {
 // CinnamonChiplet::CinnamonChiplet(uint32_t chipletID, const uint32_t output_level, Interfaces::StandardMem * memory){
 	
     const uint32_t output_level = (uint32_t)params.find<uint32_t>("verbose", 0);
@@ -32,8 +34,37 @@ CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU *
     numBcuBuffs = params.find<uint16_t>("numBcuBuffs", 2);
     numEvgUnits = params.find<uint16_t>("numEvgUnits", 1);
     config.usePRNG = params.find<bool>("usePRNG", true);
+    config.modelScalarLoads = params.find<bool>("modelScalarLoads", true);
 
-	output->verbose(CALL_INFO, 1, 0, "Use PRNG: %s\n", config.usePRNG ? "true" : "false");
+	CINNAMON_VERBOSE(output, 1, 0, "Use PRNG: %s\n", config.usePRNG ? "true" : "false");
+
+	eventLog_ = cpu->eventLog();
+	if(eventLog_) {
+		frontendTrack = addEventTrack("frontend");
+		issueTrack = addEventTrack("issue");
+		registerTrack = addEventTrack("vectorRegisters");
+		networkTrack = addEventTrack("networkPort");
+	}
+	statistics_.instructionsDispatched = registerStatistic<uint64_t>("instructions_dispatched");
+	statistics_.computeBusyCycles = registerStatistic<uint64_t>("compute_busy_cycles");
+	statistics_.vectorRegisterReads = registerStatistic<uint64_t>("vector_register_reads");
+	statistics_.vectorRegisterWrites = registerStatistic<uint64_t>("vector_register_writes");
+	statistics_.liveVectorRegisters = registerStatistic<uint64_t>("live_vector_registers");
+	statistics_.liveScalarRegisters = registerStatistic<uint64_t>("live_scalar_registers");
+	statistics_.liveBcuRegisters = registerStatistic<uint64_t>("live_bcu_registers");
+	statistics_.vectorRegisterLifetime = registerStatistic<uint64_t>("vector_register_lifetime");
+	statistics_.scalarRegisterLifetime = registerStatistic<uint64_t>("scalar_register_lifetime");
+	statistics_.vectorReadyUnread = registerStatistic<uint64_t>("vector_ready_unread");
+	statistics_.vectorRegistersUnread = registerStatistic<uint64_t>("vector_registers_unread");
+	for(size_t i = 0; i < static_cast<size_t>(CinnamonInstructionOpCode::NUM_OPCODES); i++) {
+		auto opCode = getOpCodeString(static_cast<CinnamonInstructionOpCode>(i));
+		statistics_.opcodeExecuted.push_back(registerStatistic<uint64_t>("opcode_executed", opCode));
+		statistics_.opcodeDispatchToIssue.push_back(registerStatistic<uint64_t>("opcode_dispatch_to_issue", opCode));
+		statistics_.opcodeIssueToComplete.push_back(registerStatistic<uint64_t>("opcode_issue_to_complete", opCode));
+	}
+	registerSampleInterval = params.find<SST::Cycle_t>("registerSampleInterval", 1000);
+	termReportEntries = params.find<size_t>("termReportEntries", 20);
+	stalls_.configureTrace(cpu->stallTrace(), params.find<SST::Cycle_t>("stallSampleInterval", 100000), chipletID_);
 
 
 	// Load Reader the new way
@@ -65,17 +96,35 @@ CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU *
 
 	auto & latency = cpu->latency();
 
-    Interfaces::StandardMem * memory = loadUserSubComponent<Interfaces::StandardMem>("memory", ComponentInfo::SHARE_NONE, nullptr, new Interfaces::StandardMem::Handler<CinnamonChiplet>(this, &CinnamonChiplet::handleResponse));
-    if ( !memory ) {
-        output->fatal(CALL_INFO, -1, "Unable to load memoryInterface subcomponent\n");
-    }
+	auto numMemPorts = params.find<size_t>("numMemPorts", 1);
+	std::vector<Interfaces::StandardMem *> memories;
+	for(size_t port = 0; port < numMemPorts; port++){
+		std::string slotName = "memory_" + std::to_string(port);
+		if(port == 0 && !isUserSubComponentLoadableUsingAPI<Interfaces::StandardMem>(slotName)){
+			slotName = "memory"; // Single port configurations use the plain memory slot
+		}
+		Interfaces::StandardMem * memory = loadUserSubComponent<Interfaces::StandardMem>(slotName, ComponentInfo::SHARE_NONE, nullptr, new Interfaces::StandardMem::Handler<CinnamonChiplet,size_t>(this, &CinnamonChiplet::handleResponse, port));
+		if ( !memory ) {
+			output->fatal(CALL_INFO, -1, "Unable to load memoryInterface subcomponent for slot %s\n", slotName.c_str());
+		}
+		memories.push_back(memory);
+	}
+
+	addressMapper = std::make_unique<CinnamonAddressMapper>(params,output,(64 * 1024 * 28) / 8 /* limbSize */);
 
 	auto requestWidth = params.find<size_t>("memoryRequestWidth", 1024);
-	memoryUnit = std::make_unique<CinnamonMemoryUnit>(this,cpu,output_level,memory,requestWidth);
+	auto memPortRouting = params.find<std::string>("memPortRouting", "address");
+	auto keyMemPort = params.find<size_t>("keyMemPort", 0);
+	auto scalarCacheEntries = params.find<size_t>("scalarCacheEntries", 0);
+	memoryUnit = std::make_unique<CinnamonMemoryUnit>(this,cpu,output_level,memories,addressMapper.get(),requestWidth,memPortRouting,keyMemPort,scalarCacheEntries);
+	memoryUnit->configureStoreBuffer(params.find<size_t>("storeBufferEntries", 0),
+									 params.find<std::string>("storeDrainPolicy", "eager"),
+									 params.find<size_t>("storeBufferHighWatermark", 0),
+									 params.find<size_t>("storeBufferLowWatermark", 0));
 	// functionalUnit = std::make_unique<CinnamonFunctionalUnit>(this,output_level,2);
 	std::vector<std::shared_ptr<CinnamonFunctionalUnit>> addUnits;
 	for(int i = 0; i < numAddUnits; i ++){
-		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "addFU" + std::to_string(i),output_level,latency.Add,VEC_DEPTH);
+		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "addFU" + std::to_string(i),CinnamonStallStack::Unit::Add,output_level,latency.Add,VEC_DEPTH);
 		addUnits.push_back(fu);
 		functionalUnits.push_back(fu);
 	}
@@ -83,7 +132,7 @@ CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU *
 
 	std::vector<std::shared_ptr<CinnamonFunctionalUnit>> mulUnits;
 	for(int i = 0; i < numMulUnits; i ++){
-		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "mulFU" + std::to_string(i),output_level,latency.Mul,VEC_DEPTH);
+		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "mulFU" + std::to_string(i),CinnamonStallStack::Unit::Mul,output_level,latency.Mul,VEC_DEPTH);
 		mulUnits.push_back(fu);
 		functionalUnits.push_back(fu);
 	}
@@ -95,13 +144,13 @@ CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU *
 	for(int i = 0; i < numBcuBuffs; i ++){
 		auto bcu = std::make_shared<CinnamonBaseConversionUnit>(this,i, "bcu" + std::to_string(i),output_level,latency.Bcu_read);
 		baseConversionUnits.push_back(bcu);
-		auto bcw = std::make_shared<CinnamonFunctionalUnit>(this, "bcWrite" + std::to_string(i),output_level,latency.Bcu_write,VEC_DEPTH);
+		auto bcw = std::make_shared<CinnamonFunctionalUnit>(this, "bcWrite" + std::to_string(i),CinnamonStallStack::Unit::BcWrite,output_level,latency.Bcu_write,VEC_DEPTH);
 		functionalUnits.push_back(bcw);
 		bcWriteUnits.push_back(bcw);
 	}
 
 	for(int i = 0; i < numBcuUnits; i ++){
-		auto bcr = std::make_shared<CinnamonFunctionalUnit>(this, "bcRead" + std::to_string(i),output_level,latency.Bcu_read,VEC_DEPTH*2);
+		auto bcr = std::make_shared<CinnamonFunctionalUnit>(this, "bcRead" + std::to_string(i),CinnamonStallStack::Unit::BcRead,output_level,latency.Bcu_read,VEC_DEPTH*2);
 		functionalUnits.push_back(bcr);
 		bcReadUnits.push_back(bcr);
 	}
@@ -110,13 +159,13 @@ CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU *
 
 	std::vector<std::shared_ptr<CinnamonFunctionalUnit>> nttUnits;
 	for(int i = 0; i < numNTTUnits; i ++){
-		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "nttFU" + std::to_string(i),output_level,latency.NTT,VEC_DEPTH);
+		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "nttFU" + std::to_string(i),CinnamonStallStack::Unit::Ntt,output_level,latency.NTT,VEC_DEPTH);
 		nttUnits.push_back(fu);
 		functionalUnits.push_back(fu);
 	}
 	std::vector<std::shared_ptr<CinnamonFunctionalUnit>> transposeUnits;
 	for(int i = 0; i < numTraUnits; i ++){
-		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "traFU" + std::to_string(i),output_level,latency.Transpose,VEC_DEPTH);
+		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "traFU" + std::to_string(i),CinnamonStallStack::Unit::Transpose,output_level,latency.Transpose,VEC_DEPTH);
 		transposeUnits.push_back(fu);
 		functionalUnits.push_back(fu);
 	}
@@ -126,7 +175,7 @@ CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU *
 
 	std::vector<std::shared_ptr<CinnamonFunctionalUnit>> rotateUnits;
 	for(int i = 0; i < numRotUnits; i ++){
-		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "rotFU" + std::to_string(i),output_level,latency.Rot,VEC_DEPTH);
+		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "rotFU" + std::to_string(i),CinnamonStallStack::Unit::Rot,output_level,latency.Rot,VEC_DEPTH);
 		rotateUnits.push_back(fu);
 		functionalUnits.push_back(fu);
 	}
@@ -135,7 +184,7 @@ CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU *
 	
 	std::vector<std::shared_ptr<CinnamonFunctionalUnit>> evgUnits;
 	for(int i = 0; i < numEvgUnits; i ++){
-		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "evgFU" + std::to_string(i),output_level,latency.Evg,VEC_DEPTH);
+		auto fu = std::make_shared<CinnamonFunctionalUnit>(this, "evgFU" + std::to_string(i),CinnamonStallStack::Unit::Evg,output_level,latency.Evg,VEC_DEPTH);
 		evgUnits.push_back(fu);
 		functionalUnits.push_back(fu);
 	}
@@ -150,7 +199,7 @@ CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU *
 
 	std::vector<std::shared_ptr<CinnamonFunctionalUnit>> rsvUnits;
 	for(int i = 0; i < 1; i ++){
-		auto rsv = std::make_shared<CinnamonFunctionalUnit>(this, "rsv" + std::to_string(i),output_level,latency.Rsv,VEC_DEPTH*16);
+		auto rsv = std::make_shared<CinnamonFunctionalUnit>(this, "rsv" + std::to_string(i),CinnamonStallStack::Unit::Rsv,output_level,latency.Rsv,VEC_DEPTH*16);
 		functionalUnits.push_back(rsv);
 		rsvUnits.push_back(rsv);
 	}
@@ -159,14 +208,18 @@ CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU *
 
 	std::vector<std::shared_ptr<CinnamonFunctionalUnit>> modUnits;
 	for(int i = 0; i < 1; i ++){
-		auto mod = std::make_shared<CinnamonFunctionalUnit>(this, "mod" + std::to_string(i),output_level,latency.Mod,VEC_DEPTH*16);
+		auto mod = std::make_shared<CinnamonFunctionalUnit>(this, "mod" + std::to_string(i),CinnamonStallStack::Unit::Mod,output_level,latency.Mod,VEC_DEPTH*16);
 		functionalUnits.push_back(mod);
 		modUnits.push_back(mod);
 	}
 
 	modQueue = std::make_unique<CinnamonModQueue>(this,"modQueue",output_level,latency,modUnits);
 
-	disQueue = std::make_unique<CinnamonDisQueue>(this,cpu,"disQueue",output_level,network,networkLink);
+	auto maxInFlightNetworkOps = params.find<size_t>("maxInFlightNetworkOps", 1);
+	if(maxInFlightNetworkOps == 0) {
+		output->fatal(CALL_INFO, -1, "maxInFlightNetworkOps must be non-zero\n");
+	}
+	disQueue = std::make_unique<CinnamonDisQueue>(this,cpu,"disQueue",output_level,network,networkLink,maxInFlightNetworkOps);
 
 	for(int i = 0; i < numVectorRegs; i++){
 		auto vreg = std::make_shared<PhysicalRegister>(this,PhysicalRegister::PhysicalRegister_t::Vector,i);
@@ -188,12 +241,12 @@ CinnamonChiplet::CinnamonChiplet(ComponentId_t id, Params &params, CinnamonCPU *
 
 
 
-	output->verbose(CALL_INFO, 1, 0, "Cinnamon configuration completed successfully.\n");
+	CINNAMON_VERBOSE(output, 1, 0, "Cinnamon configuration completed successfully.\n");
 }
 
 
-void CinnamonChiplet::handleResponse(Interfaces::StandardMem::Request * response_ptr) {
-	memoryUnit->handleResponse(response_ptr);
+void CinnamonChiplet::handleResponse(Interfaces::StandardMem::Request * response_ptr, size_t port) {
+	memoryUnit->handleResponse(response_ptr,port);
 }
 
 
@@ -223,6 +276,7 @@ void CinnamonChiplet::finish() {
 	output->output("- Completed at:                          %" PRIu64 " ns\n", nanoSeconds);
 	output->output("------------------------------------------------------------------------\n");
 	output->output("%s",memoryUnit->printStats().c_str());
+	memoryUnit->finish();
 	output->output("------------------------------------------------------------------------\n");
 	for(auto &fu: functionalUnits) {
 		output->output("%s",fu->printStats().c_str());
@@ -232,8 +286,24 @@ void CinnamonChiplet::finish() {
     s << "Register File:\n";
 	s << "\tVector Register Reads : " << stats_.vectorRegisterReads << "\n";
 	s << "\tVector Register Writes: " << stats_.vectorRegisterWrites << "\n";
+	s << "\tMax Live Vector Registers: " << stats_.maxLiveVectorRegisters << " of " << numVectorRegs << "\n";
 	output->output("- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - \n");
 	output->output("%s",s.str().c_str());
+	output->output("- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - \n");
+	output->output("%s",stalls_.printStats().c_str());
+	output->output("- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - \n");
+	output->output("%s",opcodeStats_.printStats("Opcodes", false).c_str());
+	if(energy_.configured()) {
+		output->output("- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - \n");
+		output->output("%s",energy_.printStats(activity(), nanoSeconds).c_str());
+	}
+	if(!termTraffic_.empty()) {
+		output->output("- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - \n");
+		output->output("%s",termTraffic_.printStats(termReportEntries).c_str());
+		if(cpu->termTraffic()) {
+			termTraffic_.writeCsv(*cpu->termTraffic(), chipletID_);
+		}
+	}
 	output->output("------------------------------------------------------------------------\n");
 }
 
@@ -249,6 +319,7 @@ bool CinnamonChiplet::canMapToPhysicalRegister(const CinnamonParsedValueType & v
 								mappable = true;
 								return;
 							}
+							stalls_.dispatchBlocked(CinnamonStallStack::Dispatch::VectorRegisters);
 							// if(it != vectorRegisterRenameMap.end()){
 							// 	if(vectorRegisters.at(it->second)->numReferences() == 1){
 							// 		mappable = true;
@@ -262,6 +333,7 @@ bool CinnamonChiplet::canMapToPhysicalRegister(const CinnamonParsedValueType & v
 								mappable = true;
 								return;
 							}
+							stalls_.dispatchBlocked(CinnamonStallStack::Dispatch::ScalarRegisters);
 							// if(it != scalarRegisterRenameMap.end()){
 							// 	if(scalarRegisters.at(it->second)->numReferences() == 1){
 							// 		mappable = true;
@@ -290,9 +362,13 @@ std::shared_ptr<PhysicalRegister> CinnamonChiplet::mapToPhysicalRegister(const C
 							freeVectorRegisters.pop();
 							vectorRegisterRenameMap[arg.id] = freeVRegID;
 							mappedRegister = vectorRegisters.at(vectorRegisterRenameMap.at(arg.id)); 
+							mappedRegister->allocate();
+							stats_.maxLiveVectorRegisters = std::max(stats_.maxLiveVectorRegisters, numVectorRegs - freeVectorRegisters.size());
 							// mappedRegister->setMapped(arg.id);
 							mappedRegister->incReference();
+							mappedRegister->setProducer(CinnamonStallStack::producerOf(fetchedInstruction->opCode));
 							stats_.vectorRegisterWrites++;
+							statistics_.vectorRegisterWrites->addData(1);
 						  },
 						  [&](const CinnamonParsedScalarReg &arg)
 						  { 
@@ -306,8 +382,10 @@ std::shared_ptr<PhysicalRegister> CinnamonChiplet::mapToPhysicalRegister(const C
 							freeScalarRegisters.pop();
 							scalarRegisterRenameMap[arg.id] = freeSRegID;
 							mappedRegister = scalarRegisters.at(scalarRegisterRenameMap.at(arg.id)); 
+							mappedRegister->allocate();
 							// mappedRegister->setMapped(arg.id);
 							mappedRegister->incReference();
+							mappedRegister->setProducer(CinnamonStallStack::producerOf(fetchedInstruction->opCode));
 							
 						}}, val);
 	// mappedRegister->incReference();
@@ -328,6 +406,7 @@ std::shared_ptr<PhysicalRegister> CinnamonChiplet::getMappedPhysicalRegister(con
 								vectorRegisterRenameMap.erase(arg.id);
 							} 
 							stats_.vectorRegisterReads++;
+							statistics_.vectorRegisterReads->addData(1);
 						  },
 						  [&](const CinnamonParsedScalarReg &arg)
 						  {
@@ -393,38 +472,47 @@ bool CinnamonChiplet::dispatchMemoryInstruction(SST::Cycle_t currentCycle, const
 	auto & srcs = instruction->srcs;
 	assert(srcs.size() == 1);
 	auto term = std::get<CinnamonParsedTerm>(srcs[0]);
-	auto it = termToAddressMap.find(term.term);
-	if(it == termToAddressMap.end()){
-		addr = numTerms;
-		addr *= limbSize;
-		termToAddressMap[term.term] = addr;
-		output->verbose(CALL_INFO, 3, 0, "%s: [Time: %lu] Mapping Term %s to Address : %" PRIx64 "\n", getName().c_str(), currentCycle, term.term.c_str(), addr);
-		numTerms++;
-	} else {
-		addr = it->second;
+	auto numTerms = addressMapper->numTerms();
+	addr = addressMapper->mapTerm(term.term);
+	if(addressMapper->numTerms() != numTerms){
+		CINNAMON_VERBOSE(output, 3, 0, "%s: [Time: %lu] Mapping Term %s to Address : %" PRIx64 " (Physical: %" PRIx64 ")\n", getName().c_str(), currentCycle, term.term.c_str(), addr, addressMapper->translate(addr));
 	}
 	// if(term.free_from_mem){
 	// 	termToAddressMap.erase(term.term);
 	// }
 
+	if(op == OpCode::Store || op == OpCode::Spill) {
+		// Look for an alias before requiring a free entry, since quashing it frees the entry this store takes over
+		if(op == OpCode::Store) {
+			memoryUnit->findStoreAlias(addr,true /* Quash aliasing store since it is being overwritten */);
+		} else {
+			memoryUnit->findStoreAlias(addr,false/* Don't quash aliasing store since this spill itself might get quashed. However quash aliasing spills */);
+		}
+		if(!memoryUnit->canAcceptStore()) {
+			stalls_.dispatchBlocked(CinnamonStallStack::Dispatch::StoreBuffer);
+			return false;
+		}
+	}
+	const bool isKey = addressMapper->termClass(term.term) == CinnamonAddressMapper::TermClass::Key;
+
 	if(op == OpCode::Store) {
-		auto aliasPhyReg = memoryUnit->findStoreAlias(addr,true /* Quash aliasing store since it is being overwritten */);
 		destReg = getMappedPhysicalRegister(dests[0]);
 		destReg->incReference();
 		size = limbSize;
-		auto dispatchInstruction  = std::make_shared<CinnamonMemoryInstruction>(op,destReg,addr,size);
+		auto dispatchInstruction  = makeInstruction<CinnamonMemoryInstruction>(op,destReg,addr,size);
 		memoryUnit->addToStoreQueue(dispatchInstruction);
-		output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+		termTraffic_.store(term.term, isKey, size, false);
+		CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 	} else if(op == OpCode::Spill) {
-		auto aliasPhyReg = memoryUnit->findStoreAlias(addr,false/* Don't quash aliasing store since this spill itself might get quashed. However quash aliasing spills */);
 		destReg = getMappedPhysicalRegister(dests[0]);
 		destReg->incReference();
 		size = limbSize;
-		auto dispatchInstruction  = std::make_shared<CinnamonMemoryInstruction>(op,destReg,addr,size);
+		auto dispatchInstruction  = makeInstruction<CinnamonMemoryInstruction>(op,destReg,addr,size);
 		memoryUnit->addToStoreQueue(dispatchInstruction);
-		output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+		termTraffic_.store(term.term, isKey, size, true);
+		CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 	} else if(op == OpCode::LoadV){
-		auto aliasPhyReg = memoryUnit->findStoreAlias(addr,false /*Don't quash pending stores. Only spills will be quashed */);
+		auto aliasPhyReg = memoryUnit->findStoreAlias(addr,false /*Don't quash pending stores. Only spills will be quashed */, true /* isLoad */);
 		size = limbSize;
 		if(aliasPhyReg != nullptr){
 			auto arg = std::get<CinnamonParsedVectorReg>(dests[0]);
@@ -437,6 +525,7 @@ bool CinnamonChiplet::dispatchMemoryInstruction(SST::Cycle_t currentCycle, const
 			vectorRegisterRenameMap[arg.id] = aliasPhyReg->getID();
 			destReg = aliasPhyReg;
 			destReg->incReference();
+			termTraffic_.load(term.term, isKey, size, true, numInstructions, currentCycle);
 			return true;
 		}
 		aliasPhyReg = memoryUnit->findLoadAlias(addr);
@@ -451,6 +540,7 @@ bool CinnamonChiplet::dispatchMemoryInstruction(SST::Cycle_t currentCycle, const
 			destReg = aliasPhyReg;
 			destReg->incReference();
 			// destReg->setMapped();
+			termTraffic_.load(term.term, isKey, size, true, numInstructions, currentCycle);
 			return true;
 		}
 		if(canMapToPhysicalRegister(dests[0]) == false){
@@ -458,11 +548,12 @@ bool CinnamonChiplet::dispatchMemoryInstruction(SST::Cycle_t currentCycle, const
 		}
 		destReg = mapToPhysicalRegister(dests[0]);
 		destReg->incReference();
-		auto dispatchInstruction  = std::make_shared<CinnamonMemoryInstruction>(op,destReg,addr,size);
+		auto dispatchInstruction  = makeInstruction<CinnamonMemoryInstruction>(op,destReg,addr,size);
 		memoryUnit->addToLoadQueue(dispatchInstruction);
-		output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+		termTraffic_.load(term.term, isKey, size, false, numInstructions, currentCycle);
+		CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 	} else if(op == OpCode::LoadS) {
-
+		size = scalarSize;
 		auto aliasPhyReg = memoryUnit->findLoadAlias(addr);
 		if(aliasPhyReg != nullptr){
 			auto arg = std::get<CinnamonParsedScalarReg>(dests[0]);
@@ -474,6 +565,7 @@ bool CinnamonChiplet::dispatchMemoryInstruction(SST::Cycle_t currentCycle, const
 			scalarRegisterRenameMap[arg.id] = aliasPhyReg->getID();
 			destReg = aliasPhyReg;
 			destReg->incReference();
+			termTraffic_.load(term.term, isKey, size, true, numInstructions, currentCycle);
 			return true;
 		}
 		// if(freeScalarRegisters.size() < 1){
@@ -484,14 +576,16 @@ bool CinnamonChiplet::dispatchMemoryInstruction(SST::Cycle_t currentCycle, const
 		}
 		destReg = mapToPhysicalRegister(dests[0]);
 		destReg->incReference();
-		size = scalarSize;
-		auto dispatchInstruction  = std::make_shared<CinnamonMemoryInstruction>(op,destReg,addr,size);
+		auto dispatchInstruction  = makeInstruction<CinnamonMemoryInstruction>(op,destReg,addr,size);
 
-		// Scalar loads don't take any time
-		dispatchInstruction->setExecutionComplete();
-		// memoryUnit->addToLoadQueue(dispatchInstruction);
-		// output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
-		// return true;
+		if(config.modelScalarLoads){
+			memoryUnit->addToScalarQueue(dispatchInstruction);
+			CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+		} else {
+			// Scalar loads don't take any time
+			dispatchInstruction->setExecutionComplete();
+		}
+		termTraffic_.load(term.term, isKey, size, !config.modelScalarLoads, numInstructions, currentCycle);
 	}
 
 	return true;
@@ -529,7 +623,7 @@ bool CinnamonChiplet::dispatchBinOpInstruction(SST::Cycle_t currentCycle, const
 	src2Reg->incReference();
 
 
-	auto dispatchInstruction  = std::make_shared<CinnamonBinOpInstruction>(op,destReg,src1Reg,src2Reg,baseIndex);
+	auto dispatchInstruction  = makeInstruction<CinnamonBinOpInstruction>(op,destReg,src1Reg,src2Reg,baseIndex);
 	// functionalUnit->addToQueue(dispatchInstruction);
 	switch(op){
 		case OpCode::Add:
@@ -539,10 +633,11 @@ bool CinnamonChiplet::dispatchBinOpInstruction(SST::Cycle_t currentCycle, const
 		case OpCode::Mul:
 			mulQueue->addToInstructionQueue(dispatchInstruction);
 			break;
-
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -578,9 +673,9 @@ bool CinnamonChiplet::dispatchUnOpInstruction(SST::Cycle_t currentCycle, const s
 	std::shared_ptr<CinnamonUnOpInstruction> dispatchInstruction;
 	if(op == OpCode::Rot){
 		auto rotIndex = instruction->rotIndex;
-		dispatchInstruction  = std::make_shared<CinnamonUnOpInstruction>(op,rotIndex.value(),destReg,src1Reg,baseIndex);
+		dispatchInstruction  = makeInstruction<CinnamonUnOpInstruction>(op,rotIndex.value(),destReg,src1Reg,baseIndex);
 	} else {
-		dispatchInstruction  = std::make_shared<CinnamonUnOpInstruction>(op,destReg,src1Reg,baseIndex);
+		dispatchInstruction  = makeInstruction<CinnamonUnOpInstruction>(op,destReg,src1Reg,baseIndex);
 	}
 	// functionalUnit->addToQueue(dispatchInstruction);
 	switch(op){
@@ -594,9 +689,11 @@ bool CinnamonChiplet::dispatchUnOpInstruction(SST::Cycle_t currentCycle, const s
 		case OpCode::Con:
 			rotQueue->addToInstructionQueue(dispatchInstruction);
 			break;
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -622,15 +719,17 @@ bool CinnamonChiplet::dispatchEvgInstruction(SST::Cycle_t currentCycle, const st
 	std::shared_ptr<PhysicalRegister> destReg = mapToPhysicalRegister(dests[0]);
 	destReg->incReference();
 
-	auto dispatchInstruction  = std::make_shared<CinnamonEvgInstruction>(op,destReg,baseIndex);
+	auto dispatchInstruction  = makeInstruction<CinnamonEvgInstruction>(op,destReg,baseIndex);
 	// functionalUnit->addToQueue(dispatchInstruction);
 	switch(op){
 		case OpCode::EvkGen:
 			evgQueue->addToInstructionQueue(dispatchInstruction);
 			break;
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -668,21 +767,23 @@ bool CinnamonChiplet::dispatchNttInstruction(SST::Cycle_t currentCycle, const st
 						  { 
 							std::shared_ptr<PhysicalRegister> src1Reg = getMappedPhysicalRegister(srcs[0]);
 							src1Reg->incReference();
-							dispatchInstruction  = std::make_shared<CinnamonNttInstruction>(op,destReg,src1Reg,baseIndex);
+							dispatchInstruction  = makeInstruction<CinnamonNttInstruction>(op,destReg,src1Reg,baseIndex);
 						  },
 						  [&](CinnamonParsedBcuReg &arg)
 						  { 
 							std::shared_ptr<BaseConversionRegister> src1BcuVirtReg = getMappedBaseConversionVirtualRegister(arg);
 							src1BcuVirtReg->incReference();
-							dispatchInstruction  = std::make_shared<CinnamonNttInstruction>(op,destReg,src1BcuVirtReg,baseIndex);
+							dispatchInstruction  = makeInstruction<CinnamonNttInstruction>(op,destReg,src1BcuVirtReg,baseIndex);
 						}}, srcs[0]);
 	switch(op){
 		case OpCode::Ntt:
 			nttQueue->addToInstructionQueue(dispatchInstruction);
 			break;
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -722,13 +823,13 @@ bool CinnamonChiplet::dispatchSuDInstruction(SST::Cycle_t currentCycle, const st
 						  { 
 							std::shared_ptr<PhysicalRegister> src2Reg = getMappedPhysicalRegister(srcs[1]);
 							src2Reg->incReference();
-							dispatchInstruction  = std::make_shared<CinnamonSuDInstruction>(op,destReg,src1Reg,src2Reg,baseIndex);
+							dispatchInstruction  = makeInstruction<CinnamonSuDInstruction>(op,destReg,src1Reg,src2Reg,baseIndex);
 						  },
 						  [&](CinnamonParsedBcuReg &arg)
 						  { 
 							std::shared_ptr<BaseConversionRegister> src2BcuVirtReg = getMappedBaseConversionVirtualRegister(arg);
 							src2BcuVirtReg->incReference();
-							dispatchInstruction  = std::make_shared<CinnamonSuDInstruction>(op,destReg,src1Reg,src2BcuVirtReg,baseIndex);
+							dispatchInstruction  = makeInstruction<CinnamonSuDInstruction>(op,destReg,src1Reg,src2BcuVirtReg,baseIndex);
 						}}, srcs[1]);
 	// std::shared_ptr<PhysicalRegister> src2Reg = getMappedPhysicalRegister(srcs[1]);
 	// src2Reg->incReference();
@@ -740,9 +841,11 @@ bool CinnamonChiplet::dispatchSuDInstruction(SST::Cycle_t currentCycle, const st
 		case OpCode::SuD:
 			sudQueue->addToInstructionQueue(dispatchInstruction);
 			break;
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -754,6 +857,7 @@ bool CinnamonChiplet::dispatchBciInstruction(SST::Cycle_t currentCycle, const st
 	auto & dests = instruction->dests;
 	assert(dests.size() == 1);
 	if(freeBaseConversionVirtualRegisters.size() < dests.size()){
+		stalls_.dispatchBlocked(CinnamonStallStack::Dispatch::BcuRegisters);
 		return false;
 	}
 	auto &op = instruction->opCode;
@@ -764,15 +868,17 @@ bool CinnamonChiplet::dispatchBciInstruction(SST::Cycle_t currentCycle, const st
 	destBcuVirtReg->setReadsRemaining(dest.numReads);
 	destBcuVirtReg->setWritesRemaining(dest.numWrites);
 
-	auto dispatchInstruction  = std::make_shared<CinnamonBciInstruction>(op,destBcuVirtReg);
+	auto dispatchInstruction  = makeInstruction<CinnamonBciInstruction>(op,destBcuVirtReg);
 	// functionalUnit->addToQueue(dispatchInstruction);
 	switch(op){
 		case OpCode::Bci:
 			bciQueue->addToInstructionQueue(dispatchInstruction);
 			break;
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -784,6 +890,7 @@ bool CinnamonChiplet::dispatchPl1Instruction(SST::Cycle_t currentCycle, const st
 	auto & dests = instruction->dests;
 	assert(dests.size() == 1);
 	if(freeBaseConversionVirtualRegisters.size() < dests.size()){
+		stalls_.dispatchBlocked(CinnamonStallStack::Dispatch::BcuRegisters);
 		return false;
 	}
 	auto &op = instruction->opCode;
@@ -799,15 +906,17 @@ bool CinnamonChiplet::dispatchPl1Instruction(SST::Cycle_t currentCycle, const st
 	std::shared_ptr<PhysicalRegister> src1Reg = getMappedPhysicalRegister(srcs[0]);
 	src1Reg->incReference();
 
-	auto dispatchInstruction  = std::make_shared<CinnamonPl1Instruction>(op,destBcuVirtReg,src1Reg,baseIndex);
+	auto dispatchInstruction  = makeInstruction<CinnamonPl1Instruction>(op,destBcuVirtReg,src1Reg,baseIndex);
 	// functionalUnit->addToQueue(dispatchInstruction);
 	switch(op){
 		case OpCode::Pl1:
 			pl1Queue->addToInstructionQueue(dispatchInstruction);
 			break;
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -819,6 +928,7 @@ bool CinnamonChiplet::dispatchBcwInstruction(SST::Cycle_t currentCycle, const st
 	auto & dests = instruction->dests;
 	assert(dests.size() == 1);
 	if(freeBaseConversionVirtualRegisters.size() < dests.size()){
+		stalls_.dispatchBlocked(CinnamonStallStack::Dispatch::BcuRegisters);
 		return false;
 	}
 	auto &op = instruction->opCode;
@@ -834,15 +944,17 @@ bool CinnamonChiplet::dispatchBcwInstruction(SST::Cycle_t currentCycle, const st
 	std::shared_ptr<PhysicalRegister> src1Reg = getMappedPhysicalRegister(srcs[0]);
 	src1Reg->incReference();
 
-	auto dispatchInstruction  = std::make_shared<CinnamonBcwInstruction>(op,destBcuVirtReg,src1Reg,baseIndex);
+	auto dispatchInstruction  = makeInstruction<CinnamonBcwInstruction>(op,destBcuVirtReg,src1Reg,baseIndex);
 	// functionalUnit->addToQueue(dispatchInstruction);
 	switch(op){
 		case OpCode::BcW:
 			bcwQueue->addToInstructionQueue(dispatchInstruction);
 			break;
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -855,6 +967,7 @@ bool CinnamonChiplet::dispatchPl2Instruction(SST::Cycle_t currentCycle, const st
 	auto & dests = instruction->dests;
 	assert(dests.size() == 2);
 	if(freeBaseConversionVirtualRegisters.size() < 1){
+		stalls_.dispatchBlocked(CinnamonStallStack::Dispatch::BcuRegisters);
 		return false;
 	}
 	// if(freeVectorRegisters.size() < 1){
@@ -882,7 +995,7 @@ bool CinnamonChiplet::dispatchPl2Instruction(SST::Cycle_t currentCycle, const st
 	std::shared_ptr<PhysicalRegister> src2Reg = getMappedPhysicalRegister(srcs[1]);
 	src2Reg->incReference();
 
-	auto dispatchInstruction  = std::make_shared<CinnamonPl2Instruction>(op,destBcuVirtReg,dest2Reg,srcBcuVirtReg,src1.id.value(),src2Reg,baseIndex);
+	auto dispatchInstruction  = makeInstruction<CinnamonPl2Instruction>(op,destBcuVirtReg,dest2Reg,srcBcuVirtReg,src1.id.value(),src2Reg,baseIndex);
 	// functionalUnit->addToQueue(dispatchInstruction);
 	switch(op){
 		case OpCode::Pl2:
@@ -890,7 +1003,7 @@ bool CinnamonChiplet::dispatchPl2Instruction(SST::Cycle_t currentCycle, const st
 			break;
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -902,6 +1015,7 @@ bool CinnamonChiplet::dispatchPl3Instruction(SST::Cycle_t currentCycle, const st
 	auto & dests = instruction->dests;
 	assert(dests.size() == 1);
 	if(freeBaseConversionVirtualRegisters.size() < 1){
+		stalls_.dispatchBlocked(CinnamonStallStack::Dispatch::BcuRegisters);
 		return false;
 	}
 	auto &op = instruction->opCode;
@@ -919,7 +1033,7 @@ bool CinnamonChiplet::dispatchPl3Instruction(SST::Cycle_t currentCycle, const st
 	std::shared_ptr<PhysicalRegister> src2Reg = getMappedPhysicalRegister(srcs[1]);
 	src2Reg->incReference();
 
-	auto dispatchInstruction  = std::make_shared<CinnamonPl3Instruction>(op,destBcuVirtReg,src1Reg,src2Reg,baseIndex);
+	auto dispatchInstruction  = makeInstruction<CinnamonPl3Instruction>(op,destBcuVirtReg,src1Reg,src2Reg,baseIndex);
 	// functionalUnit->addToQueue(dispatchInstruction);
 	switch(op){
 		case OpCode::Pl3:
@@ -927,7 +1041,7 @@ bool CinnamonChiplet::dispatchPl3Instruction(SST::Cycle_t currentCycle, const st
 			break;
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -962,7 +1076,7 @@ bool CinnamonChiplet::dispatchPl4Instruction(SST::Cycle_t currentCycle, const st
 	std::shared_ptr<PhysicalRegister> src3Reg = getMappedPhysicalRegister(srcs[2]);
 	src3Reg->incReference();
 
-	auto dispatchInstruction  = std::make_shared<CinnamonPl4Instruction>(op,destReg,src1BcuVirtReg,src1.id.value(),src2Reg,src3Reg,baseIndex);
+	auto dispatchInstruction  = makeInstruction<CinnamonPl4Instruction>(op,destReg,src1BcuVirtReg,src1.id.value(),src2Reg,src3Reg,baseIndex);
 	// functionalUnit->addToQueue(dispatchInstruction);
 	switch(op){
 		case OpCode::Pl4:
@@ -970,7 +1084,7 @@ bool CinnamonChiplet::dispatchPl4Instruction(SST::Cycle_t currentCycle, const st
 			break;
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -1008,6 +1122,7 @@ bool CinnamonChiplet::dispatchRsvInstruction(SST::Cycle_t currentCycle, const st
 
 	if(op == OpCode::Rsi) {
 		if(freeVectorRegisters.size() < dests.size()){
+			stalls_.dispatchBlocked(CinnamonStallStack::Dispatch::VectorRegisters);
 			return false;
 		}
 	}
@@ -1033,16 +1148,18 @@ bool CinnamonChiplet::dispatchRsvInstruction(SST::Cycle_t currentCycle, const st
 		}
 	}
 
-	auto dispatchInstruction  = std::make_shared<CinnamonRsvInstruction>(op,destRegs,src1Reg,baseIndex);
+	auto dispatchInstruction  = makeInstruction<CinnamonRsvInstruction>(op,destRegs,src1Reg,baseIndex);
 
 	switch(op){
 		case OpCode::Rsv:
 		case OpCode::Rsi:
 			rsvQueue->addToInstructionQueue(dispatchInstruction);
 			break;
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -1074,15 +1191,17 @@ bool CinnamonChiplet::dispatchModInstruction(SST::Cycle_t currentCycle, const st
 		srcRegs.push_back(srcReg);
 	}
 
-	auto dispatchInstruction  = std::make_shared<CinnamonModInstruction>(op,destReg,srcRegs,baseIndex);
+	auto dispatchInstruction  = makeInstruction<CinnamonModInstruction>(op,destReg,srcRegs,baseIndex);
 
 	switch(op){
 		case OpCode::Mod:
 			modQueue->addToInstructionQueue(dispatchInstruction);
 			break;
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -1114,18 +1233,31 @@ bool CinnamonChiplet::dispatchDisInstruction(SST::Cycle_t currentCycle, const st
 		assert(srcs.size() == 1);
 		srcReg = getMappedPhysicalRegister(srcs[0]);
 		srcReg->incReference();
+	} else if(op == OpCode::A2a) {
+		assert(dests.size() == 1);
+		assert(srcs.size() == 1);
+		if(canMapToPhysicalRegister(dests[0]) == false){
+			return false;
+		}
+		srcReg = getMappedPhysicalRegister(srcs[0]);
+		srcReg->incReference();
+		destReg = mapToPhysicalRegister(dests[0]);
+		destReg->incReference();
 	}
 
-	auto dispatchInstruction  = std::make_shared<CinnamonDisInstruction>(op,destReg,srcReg,syncID.value(),syncSize.value());
+	auto dispatchInstruction  = makeInstruction<CinnamonDisInstruction>(op,destReg,srcReg,syncID.value(),syncSize.value());
 
 	switch(op){
 		case OpCode::Dis:
 		case OpCode::Rcv:
+		case OpCode::A2a:
 			disQueue->addToInstructionQueue(dispatchInstruction);
 			break;
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -1162,15 +1294,17 @@ bool CinnamonChiplet::dispatchJoiInstruction(SST::Cycle_t currentCycle, const st
 	}
 	// assert(srcs.size() == 1);
 
-	auto dispatchInstruction  = std::make_shared<CinnamonDisInstruction>(op,destReg,srcReg,syncID.value(),syncSize.value(),baseIndex);
+	auto dispatchInstruction  = makeInstruction<CinnamonDisInstruction>(op,destReg,srcReg,syncID.value(),syncSize.value(),baseIndex);
 
 	switch(op){
 		case OpCode::Joi:
 			disQueue->addToInstructionQueue(dispatchInstruction);
 			break;
+		default:
+			throw std::invalid_argument("Unhandled OpCode: " + getOpCodeString(op));
 	}
 
-	output->verbose(CALL_INFO, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
+	CINNAMON_VERBOSE(output, 3, 0, "%s: %lu Dispatching Instruction: %s\n", getName().c_str(), currentCycle, dispatchInstruction->getString().c_str() );
 
 	return true;
 
@@ -1183,18 +1317,121 @@ bool CinnamonChiplet::dispatchJoiInstruction(SST::Cycle_t currentCycle, const st
  * 
  * Simulates a clock cycle
  */
+uint32_t CinnamonChiplet::addEventTrack(const std::string & name) {
+	if(!eventLog_) {
+		return CinnamonEventLog::NoTrack;
+	}
+	return eventLog_->addTrack(chipletID_, name);
+}
+
+void CinnamonChiplet::logEvent(CinnamonEventLog::Kind kind, const CinnamonInstruction & instruction, uint32_t track, SST::Cycle_t begin, SST::Cycle_t end) {
+	eventLog_->record(kind, chipletID_, track, instruction.getTraceID(), static_cast<uint8_t>(instruction.getOpCode()), begin, end);
+}
+
+void CinnamonChiplet::logIssueEvent(CinnamonEventLog::Kind kind, const CinnamonInstruction & instruction) {
+	logEvent(kind, instruction, issueTrack, currentCycle_, currentCycle_);
+}
+
+void CinnamonChiplet::instructionCompleted(const CinnamonInstruction & instruction) {
+	completions_++;
+	auto opCode = instruction.getOpCode();
+	if(opCode == CinnamonInstructionOpCode::Nop) {
+		return;
+	}
+	SST::Cycle_t dispatched = instruction.getDispatchCycle();
+	SST::Cycle_t issued = instruction.getIssueCycle().value_or(dispatched);
+	opcodeStats_.record(opCode, issued - dispatched, currentCycle_ - issued);
+	auto i = static_cast<size_t>(opCode);
+	statistics_.opcodeExecuted[i]->addData(1);
+	statistics_.opcodeDispatchToIssue[i]->addData(issued - dispatched);
+	statistics_.opcodeIssueToComplete[i]->addData(currentCycle_ - issued);
+}
+
+void CinnamonChiplet::sampleRegisters() {
+	statistics_.liveVectorRegisters->addData(vectorRegisters.size() - freeVectorRegisters.size());
+	statistics_.liveScalarRegisters->addData(scalarRegisters.size() - freeScalarRegisters.size());
+	statistics_.liveBcuRegisters->addData(baseConversionVirtualRegisters.size() - freeBaseConversionVirtualRegisters.size());
+}
+
+bool CinnamonChiplet::usesSimpleHBM() const {
+	return memoryUnit->usesSimpleHBM();
+}
+
+CinnamonEnergyModel::Activity CinnamonChiplet::activity() const {
+	CinnamonEnergyModel::Activity activity;
+	for(auto & fu: functionalUnits) {
+		auto unit = static_cast<size_t>(fu->getUnit());
+		activity.issueCycles[unit] += fu->issueCycles();
+		activity.instances[unit]++;
+	}
+	activity.vectorRegisterReads = stats_.vectorRegisterReads;
+	activity.vectorRegisterWrites = stats_.vectorRegisterWrites;
+	activity.memoryBytes = memoryUnit->bytesTransferred();
+	return activity;
+}
+
+std::string CinnamonChiplet::dumpState() const {
+	std::stringstream s;
+	s << getName() << ":\n";
+	if(fetchedInstruction) {
+		s << "\tFetched: " << getOpCodeString(fetchedInstruction->opCode) << " (trace " << numInstructions
+		  << "), waiting for dispatch since cycle " << fetchedAtCycle << "\n";
+	} else {
+		s << "\tTrace completed after " << numInstructions << " instructions\n";
+	}
+	s << "\tFree Vector Registers: " << freeVectorRegisters.size() << " of " << vectorRegisters.size() << "\n";
+	s << "\tFree Scalar Registers: " << freeScalarRegisters.size() << " of " << scalarRegisters.size() << "\n";
+	s << "\tFree BCU Registers: " << freeBaseConversionVirtualRegisters.size() << " of " << baseConversionVirtualRegisters.size() << "\n";
+	// Mappings are printed as virtual->physical(references)
+	s << "\tVector Rename Map:";
+	for(auto & [virt, phy]: vectorRegisterRenameMap) {
+		auto & reg = vectorRegisters.at(phy);
+		s << " v" << virt << "->" << reg->getString() << "(" << reg->numReferences() << ")";
+	}
+	s << "\n\tScalar Rename Map:";
+	for(auto & [virt, phy]: scalarRegisterRenameMap) {
+		auto & reg = scalarRegisters.at(phy);
+		s << " s" << virt << "->" << reg->getString() << "(" << reg->numReferences() << ")";
+	}
+	s << "\n\tBCU Rename Map:";
+	for(auto & [virt, id]: baseConversionVirtualRegisterRenameMap) {
+		s << " b" << virt << "->" << baseConversionVirtualRegisters.at(id)->getString();
+	}
+	s << "\nInstruction Queues:\n";
+	for(auto queue: {addQueue.get(), mulQueue.get(), rotQueue.get(), evgQueue.get(), nttQueue.get(), sudQueue.get(), bciQueue.get(),
+					 bcwQueue.get(), pl1Queue.get(), pl2Queue.get(), pl3Queue.get(), pl4Queue.get(), rsvQueue.get(), modQueue.get(), disQueue.get()}) {
+		if(queue) {
+			s << queue->dumpState();
+		}
+	}
+	s << "Functional Units:\n";
+	for(auto & fu: functionalUnits) {
+		s << fu->dumpState();
+	}
+	for(auto & bcu: baseConversionUnits) {
+		s << bcu->dumpState();
+	}
+	s << "Memory Unit:\n";
+	s << memoryUnit->dumpState();
+	return s.str();
+}
+
 bool CinnamonChiplet::tick(SST::Cycle_t currentCycle) {
 
 	bool traceCompleted = false;
 	bool dispatched = false;
+	bool dispatchedThisCycle = false;
 
+	currentCycle_ = currentCycle;
 	if(fetchedInstruction == nullptr){
 		fetchedInstruction = reader->readNextInstruction(0);
 		numInstructions++;
+		fetchedAtCycle = currentCycle;
 	}
 
 	while(fetchedInstruction){
 		using OpCode = CinnamonInstructionOpCode;
+		auto fetchedOpCode = fetchedInstruction->opCode;
 		switch(fetchedInstruction->opCode){
 			case OpCode::LoadV:
 			case OpCode::LoadS:
@@ -1222,6 +1459,7 @@ bool CinnamonChiplet::tick(SST::Cycle_t currentCycle) {
 				} else {
 					// If PRNG is not to be used, turn the evkGen instruction into a load
 					fetchedInstruction->opCode = OpCode::LoadV;
+					addressMapper->markKeyTerm(std::get<CinnamonParsedTerm>(fetchedInstruction->srcs.at(0)).term);
 					dispatched = dispatchMemoryInstruction(currentCycle, fetchedInstruction);
 				}
 				break;
@@ -1261,6 +1499,7 @@ bool CinnamonChiplet::tick(SST::Cycle_t currentCycle) {
 				break;
 			case OpCode::Rcv:
 			case OpCode::Dis:
+			case OpCode::A2a:
 				dispatched = dispatchDisInstruction(currentCycle, fetchedInstruction);
 				break;
 			case OpCode::Joi:
@@ -1273,51 +1512,46 @@ bool CinnamonChiplet::tick(SST::Cycle_t currentCycle) {
 		if(!dispatched){
 			break;
 		} else {
+			dispatchedThisCycle = true;
+			statistics_.instructionsDispatched->addData(1);
+			if(eventLogActive()) {
+				eventLog_->record(CinnamonEventLog::Kind::Dispatch, chipletID_, frontendTrack, numInstructions,
+								  static_cast<uint8_t>(fetchedOpCode), fetchedAtCycle, currentCycle);
+			}
 			fetchedInstruction = reader->readNextInstruction(0);
 			numInstructions++;
-			if(numInstructions % 100000 == 0) {
-				uint64_t mils = numInstructions / 1000000;
-				uint64_t hundredKs = (numInstructions - mils*1000000) / 100000;
-				output->verbose(CALL_INFO, 1, 0, "%s:Heartbeat @  %lu.%lu M instructions %" PRIu64 " cycles\n",getName().c_str(),mils,hundredKs,currentCycle);
-				output->flush();
-			}
+			fetchedAtCycle = currentCycle;
 		}
 	}
 
-	if(currentCycle % 1000000 == 0) {
-		uint64_t mils = numInstructions / 1000000;
-		uint64_t hundredKs = (numInstructions - mils*1000000) / 100000;
-		output->verbose(CALL_INFO, 1, 0, "%s:Heartbeat @ %" PRIu64 " M cycles %lu.%lu M instructions\n",getName().c_str(),currentCycle/(1000000),mils,hundredKs);
-		output->flush();
-	}
-
-    if(currentCycle % 100000 == 0){
-        output->verbose(CALL_INFO, 1, 0, "%s:Heartbeat @ %" PRIu64 " 00K cycles. Compute Util Cycles: %" PRIu64 "\n",getName().c_str(),currentCycle/(100000),stats_.busyCyclesWindow);
-        output->flush();
-        stats_.busyCyclesWindow = 0;
-    }
-
 	if(!fetchedInstruction){
 		traceCompleted = true;
 	}
 
-	addQueue->tick(currentCycle);
-	mulQueue->tick(currentCycle);
-	rotQueue->tick(currentCycle);
-	evgQueue->tick(currentCycle);
-	nttQueue->tick(currentCycle);
-	sudQueue->tick(currentCycle);
-	bciQueue->tick(currentCycle);
-	bcwQueue->tick(currentCycle);
-	pl1Queue->tick(currentCycle);
-	// pl2Queue->tick(currentCycle);
-	// pl3Queue->tick(currentCycle);
-	// pl4Queue->tick(currentCycle);
-	rsvQueue->tick(currentCycle);
-	modQueue->tick(currentCycle);
-	disQueue->tick(currentCycle);
-
+	auto tickQueue = [&](CinnamonInstructionQueue * queue) {
+		stalls_.beginQueue();
+		queue->tick(currentCycle);
+		stalls_.endQueue();
+	};
+	tickQueue(addQueue.get());
+	tickQueue(mulQueue.get());
+	tickQueue(rotQueue.get());
+	tickQueue(evgQueue.get());
+	tickQueue(nttQueue.get());
+	tickQueue(sudQueue.get());
+	tickQueue(bciQueue.get());
+	tickQueue(bcwQueue.get());
+	tickQueue(pl1Queue.get());
+	// tickQueue(pl2Queue.get());
+	// tickQueue(pl3Queue.get());
+	// tickQueue(pl4Queue.get());
+	tickQueue(rsvQueue.get());
+	tickQueue(modQueue.get());
+	tickQueue(disQueue.get());
+
+	stalls_.beginQueue();
 	memoryUnit->executeCycleBegin(currentCycle);
+	stalls_.endQueue();
 	for(int i = 0; i < functionalUnits.size(); i++){
 		functionalUnits.at(i)->executeCycleBegin(currentCycle);
 	}
@@ -1331,6 +1565,13 @@ bool CinnamonChiplet::tick(SST::Cycle_t currentCycle) {
 	for(int i = 0; i < baseConversionUnits.size(); i++){
 		baseConversionUnits.at(i)->executeCycleEnd(currentCycle);
 	}
+	if(!completedAtCycle.has_value()){
+		stalls_.endCycle(currentCycle, dispatchedThisCycle, traceCompleted);
+		if(registerSampleInterval && currentCycle >= nextRegisterSample){
+			sampleRegisters();
+			nextRegisterSample = currentCycle + registerSampleInterval;
+		}
+	}
 	// fetchRequest(currentCycle);
 	// issueRequest(currentCycle);
 	// executeRequest(currentCycle);
@@ -1365,7 +1606,10 @@ bool CinnamonChiplet::tick(SST::Cycle_t currentCycle) {
         okayToFinish = okayToFinish && modQueue->okayToFinish();
 		okayToFinish = okayToFinish && disQueue->okayToFinish();
 		if(okayToFinish){
-			output->verbose(CALL_INFO, 1, 0, "CinnamonChiplet: Test Completed Successfuly\n");
+			if(!completedAtCycle.has_value()){
+				completedAtCycle = currentCycle;
+			}
+			CINNAMON_VERBOSE(output, 1, 0, "CinnamonChiplet: Test Completed Successfuly\n");
 			// primaryComponentOKToEndSim();
 			return true;    // Turn our clock off while we wait for any other CPUs to end
 		}
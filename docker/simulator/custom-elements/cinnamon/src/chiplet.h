@@ -18,6 +18,11 @@
 
 #include "physicalRegister.h"
 #include "baseConversionRegister.h"
+#include "eventLog.h"
+#include "stallStack.h"
+#include "termTraffic.h"
+#include "opcodeStats.h"
+#include "energyModel.h"
 // #include "instruction.h"
 // #include "functionalUnit.h"
 // #include "memoryUnit.h"
@@ -55,6 +60,7 @@ class CinnamonNetwork;
   // class CinnamonRegisterFileWriteUnit;
 
   class CinnamonMemoryUnit;
+  class CinnamonAddressMapper;
   class CinnamonFunctionalUnit;
   class CinnamonBaseConversionUnit;
 
@@ -86,10 +92,72 @@ public:
     return chipletID_;
   }
 
-  void addBusyCyclesWindow(SST::Cycle_t val) {
-    stats_.busyCyclesWindow += val;
+  void addComputeBusyCycles(SST::Cycle_t val) {
+    statistics_.computeBusyCycles->addData(val);
   }
 
+  // Functional, memory and network units are not SST components, so they register their statistics here
+  Statistic<uint64_t> * registerUnitStatistic(const std::string & name, const std::string & subId = "") {
+    return registerStatistic<uint64_t>(name, subId);
+  }
+
+  SST::Cycle_t currentCycle() const {
+    return currentCycle_;
+  }
+
+  // Pipeline event log. Callers check eventLogActive() before building an event
+  bool eventLogActive() const {
+    return eventLog_ && eventLog_->active(currentCycle_);
+  }
+  uint32_t addEventTrack(const std::string & name);
+  void logEvent(CinnamonEventLog::Kind kind, const CinnamonInstruction & instruction, uint32_t track, SST::Cycle_t begin, SST::Cycle_t end);
+  // Instant on the chiplet's issue track
+  void logIssueEvent(CinnamonEventLog::Kind kind, const CinnamonInstruction & instruction);
+  uint32_t networkEventTrack() const {
+    return networkTrack;
+  }
+
+  CinnamonStallStack & stallStack() {
+    return stalls_;
+  }
+
+  // Called by the units every time an instruction finishes executing
+  void instructionCompleted(const CinnamonInstruction & instruction);
+  const CinnamonOpcodeStats & opcodeStats() const {
+    return opcodeStats_;
+  }
+  // Grows with every dispatch, issue and completion. The CPU watchdog terminates the simulation when it stalls
+  uint64_t progress() const {
+    return numInstructions + stalls_.issues() + completions_;
+  }
+  // Frontend, rename, queue, unit and memory state for the watchdog
+  std::string dumpState() const;
+
+  // For the CPU's progress report
+  uint64_t instructionsFetched() const {
+    return numInstructions;
+  }
+  uint64_t traceBytes() const {
+    return reader->traceBytes();
+  }
+  uint64_t traceBytesRead() const {
+    return reader->traceBytesRead();
+  }
+  std::string traceName() const {
+    return reader->traceName();
+  }
+  // For the CPU's memory model validation
+  bool usesSimpleHBM() const;
+  bool completed() const {
+    return completedAtCycle.has_value();
+  }
+
+  // Energy coefficients and the counters they apply to, for the energy report and the CPU's power trace
+  const CinnamonEnergyModel & energyModel() const {
+    return energy_;
+  }
+  CinnamonEnergyModel::Activity activity() const;
+
   SST_ELI_REGISTER_SUBCOMPONENT_API(SST::Cinnamon::CinnamonChiplet, CinnamonCPU * , CinnamonNetwork * , uint32_t)
 
   SST_ELI_REGISTER_SUBCOMPONENT(
@@ -100,6 +168,94 @@ public:
       "Cinnamon Chiplet",
       SST::Cinnamon::CinnamonChiplet);
 
+  SST_ELI_DOCUMENT_PARAMS(
+      {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+      {"numVectorRegs", "Number of physical vector registers", "1024"},
+      {"usePRNG", "Generate evaluation keys on chip instead of loading them", "true"},
+      {"memoryRequestWidth", "Size in bytes of each request sent to memory", "1024"},
+      {"addressMapPolicy", "Term to address mapping: contiguous, limbStriped, termClass or xorHash", "contiguous"},
+      {"numMemChannels", "Number of memory channels that addresses are interleaved across", "1"},
+      {"channelInterleaveSize", "Channel interleaving granularity in bytes", "256"},
+      {"keyChannels", "Channels reserved for keys with the termClass policy", "numMemChannels/2"},
+      {"keyTermPrefixes", "Array of term name prefixes that identify keys", "[]"},
+      {"numMemPorts", "Number of memory interfaces, loaded from slots memory_0 .. memory_N-1", "1"},
+      {"memPortRouting", "Routing of memory instructions to ports: address or termClass", "address"},
+      {"keyMemPort", "Port used for keys with termClass routing", "0"},
+      {"modelScalarLoads", "Send scalar loads (loas) to memory. If false they complete immediately", "true"},
+      {"scalarCacheEntries", "Number of recently loaded scalars kept on chip. 0 disables the scalar cache", "0"},
+      {"storeBufferEntries", "Capacity of the store buffer. Dispatch of stores and spills stalls when it is full. 0 is unbounded", "0"},
+      {"storeDrainPolicy", "Store buffer drain policy: eager, loadsFirst or watermark", "eager"},
+      {"storeBufferHighWatermark", "Occupancy at which the watermark policy starts draining stores ahead of loads", "0"},
+      {"storeBufferLowWatermark", "Occupancy at which the watermark policy stops draining", "0"},
+      {"registerSampleInterval", "Cycles between samples of the live register statistics. 0 disables sampling", "1000"},
+      {"termReportEntries", "Terms listed in the per-term memory traffic report at the end of simulation. 0 lists all terms", "20"},
+      {"stallSampleInterval", "Cycles per row of the stall time series written to the CPU's stallTraceFile. 0 disables the rows", "100000"},
+      {"addEnergy", "pJ per cycle of input issued to an add unit", "0"},
+      {"mulEnergy", "pJ per cycle of input issued to a multiply unit", "0"},
+      {"nttEnergy", "pJ per cycle of input issued to an NTT unit (one column of butterflies)", "0"},
+      {"transposeEnergy", "pJ per cycle of input issued to a transpose unit", "0"},
+      {"rotEnergy", "pJ per cycle of input issued to a rotate unit", "0"},
+      {"evgEnergy", "pJ per cycle of input issued to an evaluation key generation unit", "0"},
+      {"bcReadEnergy", "pJ per cycle of input issued to a base conversion read unit", "0"},
+      {"bcWriteEnergy", "pJ per cycle of input issued to a base conversion write unit", "0"},
+      {"rsvEnergy", "pJ per cycle of input issued to the rsv unit", "0"},
+      {"modEnergy", "pJ per cycle of input issued to the mod unit", "0"},
+      {"addStaticPower", "Static power in mW of each add unit", "0"},
+      {"mulStaticPower", "Static power in mW of each multiply unit", "0"},
+      {"nttStaticPower", "Static power in mW of each NTT unit", "0"},
+      {"transposeStaticPower", "Static power in mW of each transpose unit", "0"},
+      {"rotStaticPower", "Static power in mW of each rotate unit", "0"},
+      {"evgStaticPower", "Static power in mW of each evaluation key generation unit", "0"},
+      {"bcReadStaticPower", "Static power in mW of each base conversion read unit", "0"},
+      {"bcWriteStaticPower", "Static power in mW of each base conversion write unit, including its buffer", "0"},
+      {"rsvStaticPower", "Static power in mW of the rsv unit", "0"},
+      {"modStaticPower", "Static power in mW of the mod unit", "0"},
+      {"vectorRegisterReadEnergy", "pJ per vector register operand read at dispatch", "0"},
+      {"vectorRegisterWriteEnergy", "pJ per vector register allocated at dispatch", "0"},
+      {"registerFileStaticPower", "Static power in mW of the register files", "0"},
+      {"memoryEnergyPerByte", "pJ per byte read or written through the memory ports", "0"},
+      {"maxInFlightNetworkOps", "Number of Dis/Rcv/Joi instructions that can register their syncs and wait for the network at once", "1"})
+
+  // Window and output format (CSV, JSON, HDF5) come from the statistic configuration of the run.
+  // fu_* statistics have the functional unit name as subId, mem_port_* and mem_bytes_* the port and
+  // mem_channel_* the channel
+  SST_ELI_DOCUMENT_STATISTICS(
+      {"instructions_dispatched", "Trace instructions dispatched", "instructions", 1},
+      {"compute_busy_cycles", "Lane cycles of functional unit reservations that completed", "cycles", 1},
+      {"vector_register_reads", "Vector register operand reads at dispatch", "reads", 2},
+      {"vector_register_writes", "Vector registers allocated at dispatch", "writes", 2},
+      {"live_vector_registers", "Allocated vector registers, sampled every registerSampleInterval cycles", "registers", 2},
+      {"live_scalar_registers", "Allocated scalar registers, sampled every registerSampleInterval cycles", "registers", 2},
+      {"live_bcu_registers", "Allocated base conversion virtual registers, sampled every registerSampleInterval cycles", "registers", 2},
+      {"vector_register_lifetime", "Cycles from allocating a vector register to freeing it", "cycles", 2},
+      {"scalar_register_lifetime", "Cycles from allocating a scalar register to freeing it", "cycles", 3},
+      {"vector_ready_unread", "Cycles a vector value was ready before the first instruction reading it issued, or before its free if never read", "cycles", 2},
+      {"vector_registers_unread", "Vector values freed without being read", "registers", 2},
+      {"opcode_executed", "Instructions of an opcode that completed. subId is the opcode", "instructions", 2},
+      {"opcode_dispatch_to_issue", "Cycles from dispatch of the trace instruction to the first unit reservation. subId is the opcode", "cycles", 2},
+      {"opcode_issue_to_complete", "Cycles from the first unit reservation to completion. subId is the opcode", "cycles", 2},
+      {"fu_busy_cycles", "Cycles a functional unit had an instruction in flight", "cycles", 2},
+      {"fu_issue_cycles", "Cycles of input issued to a functional unit", "cycles", 2},
+      {"mem_busy_cycles", "Cycles with any memory request outstanding", "cycles", 1},
+      {"mem_port_busy_cycles", "Cycles with a request outstanding on a memory port", "cycles", 2},
+      {"mem_bytes_read", "Bytes read through a memory port", "bytes", 1},
+      {"mem_bytes_written", "Bytes written through a memory port", "bytes", 1},
+      {"mem_channel_requests", "Requests sent to a memory channel", "requests", 3},
+      {"mem_loads", "Vector loads issued", "loads", 1},
+      {"mem_stores", "Vector stores and spills issued", "stores", 1},
+      {"mem_scalar_loads", "Scalar loads issued", "loads", 2},
+      {"mem_scalar_cache_hits", "Scalar loads served by the scalar cache", "loads", 2},
+      {"mem_latency", "Cycles from issue to completion of a vector memory request", "cycles", 1},
+      {"mem_scalar_latency", "Cycles from issue to completion of a scalar load", "cycles", 2},
+      {"store_buffer_full_stalls", "Dispatch attempts of stores and spills that found the store buffer full", "stalls", 2},
+      {"stores_coalesced", "Stores quashed by a later store to the same address", "stores", 2},
+      {"spills_elided", "Spills quashed by a reload before reaching memory", "spills", 2},
+      {"network_busy_cycles", "Cycles with network operations in flight", "cycles", 1},
+      {"network_wait_cycles", "Cycles the oldest ready network instructions waited for other chiplets", "cycles", 2},
+      {"network_backpressure_cycles", "Cycles a network instruction waited for an ingress credit", "cycles", 2},
+      {"network_issued_out_of_order", "Network instructions that issued ahead of an older one", "instructions", 2},
+      {"network_latency", "Cycles from network issue to completion", "cycles", 1})
+
   SST_ELI_DOCUMENT_PORTS(
       {"memory_link", "Link to the memory hierarchy (e.g., HBM)", {"memHierarchy.memEvent", ""}},
       {"cinnamon_network_port", "Link to the memory hierarchy (e.g., HBM)", {"memHierarchy.memEvent", ""}}
@@ -107,6 +263,7 @@ public:
 
   SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
       {"memory", "Interface to the memory hierarchy (e.g., cache)", "SST::Interfaces::StandardMem"},
+      {"memory_%(numMemPorts)d", "Interfaces to the memory hierarchy when numMemPorts > 1", "SST::Interfaces::StandardMem"},
       {"reader", "Trace Reader to use to", "SST::CinnamonCPU::TraceReader"})
 
 
@@ -115,7 +272,7 @@ private:
   CinnamonChiplet(const CinnamonChiplet &);       // Do not impl.
   void operator=(const CinnamonChiplet &); // Do not impl.
 
-  void handleResponse(SST::Interfaces::StandardMem::Request *ev);
+  void handleResponse(SST::Interfaces::StandardMem::Request *ev, size_t port);
   bool tick(Cycle_t);
 
   std::uint16_t numVectorRegs = 1024;
@@ -140,8 +297,7 @@ private:
   std::map<std::uint16_t,PhysicalRegisterID_t> vectorRegisterRenameMap;
   std::map<std::uint16_t,PhysicalRegisterID_t> scalarRegisterRenameMap;
   std::map<std::uint16_t,BaseConversionRegister::VirtualID_t> baseConversionVirtualRegisterRenameMap;
-  std::map<std::string,SST::Interfaces::StandardMem::Addr> termToAddressMap;
-  uint64_t numTerms = 0;
+  std::unique_ptr<CinnamonAddressMapper> addressMapper;
 
   std::queue<PhysicalRegisterID_t> freeVectorRegisters; 
   std::queue<PhysicalRegisterID_t> freeScalarRegisters; 
@@ -155,6 +311,13 @@ private:
   void mapSrcToDest(const CinnamonParsedVectorReg & dest, const CinnamonParsedVectorReg & src );
   std::shared_ptr<BaseConversionRegister> mapToBaseConversionVirtualRegister(const CinnamonParsedBcuInitReg & val);
   std::shared_ptr<BaseConversionRegister> getMappedBaseConversionVirtualRegister(const CinnamonParsedBcuReg & val);
+  // Creates an instruction for the trace instruction being dispatched
+  template<class Instruction, class... Args>
+  std::shared_ptr<Instruction> makeInstruction(Args &&... args) {
+    auto instruction = std::make_shared<Instruction>(std::forward<Args>(args)...);
+    instruction->setOrigin(numInstructions, currentCycle_);
+    return instruction;
+  }
   bool dispatchMemoryInstruction(SST::Cycle_t currentCycle, const std::shared_ptr<CinnamonParsedInstruction> &  instruction);
   bool dispatchEvgInstruction(SST::Cycle_t currentCycle, const std::shared_ptr<CinnamonParsedInstruction> & instruction);
   bool dispatchBinOpInstruction(SST::Cycle_t currentCycle, const std::shared_ptr<CinnamonParsedInstruction> & instruction);
@@ -203,6 +366,22 @@ private:
   std::unique_ptr<SST::Cinnamon::CinnamonTraceReader> reader;
 
   uint64_t numInstructions;
+  std::optional<SST::Cycle_t> completedAtCycle;
+  SST::Cycle_t currentCycle_ = 0;
+  SST::Cycle_t fetchedAtCycle = 0;
+
+  CinnamonEventLog * eventLog_ = nullptr;
+  uint32_t frontendTrack = CinnamonEventLog::NoTrack;
+  uint32_t issueTrack = CinnamonEventLog::NoTrack;
+  uint32_t registerTrack = CinnamonEventLog::NoTrack;
+  uint32_t networkTrack = CinnamonEventLog::NoTrack;
+
+  CinnamonStallStack stalls_;
+  CinnamonTermTraffic termTraffic_;
+  uint64_t completions_ = 0;
+  CinnamonOpcodeStats opcodeStats_;
+  CinnamonEnergyModel energy_;
+  size_t termReportEntries = 20;
 
   CinnamonCPU * cpu;
   uint32_t chipletID_;
@@ -212,14 +391,37 @@ private:
   friend class PhysicalRegister;
   friend class BaseConversionRegister;
 
+  SST::Cycle_t registerSampleInterval = 1000;
+  SST::Cycle_t nextRegisterSample = 0;
+  void sampleRegisters();
+
   struct Stats {
-      SST::Cycle_t busyCyclesWindow = 0;
       uint64_t vectorRegisterReads = 0;
       uint64_t vectorRegisterWrites = 0;
+      size_t maxLiveVectorRegisters = 0;
   } stats_;
 
+  struct Statistics {
+      Statistic<uint64_t> * instructionsDispatched;
+      Statistic<uint64_t> * computeBusyCycles;
+      Statistic<uint64_t> * vectorRegisterReads;
+      Statistic<uint64_t> * vectorRegisterWrites;
+      Statistic<uint64_t> * liveVectorRegisters;
+      Statistic<uint64_t> * liveScalarRegisters;
+      Statistic<uint64_t> * liveBcuRegisters;
+      Statistic<uint64_t> * vectorRegisterLifetime;
+      Statistic<uint64_t> * scalarRegisterLifetime;
+      Statistic<uint64_t> * vectorReadyUnread;
+      Statistic<uint64_t> * vectorRegistersUnread;
+      // Indexed by opcode
+      std::vector<Statistic<uint64_t> *> opcodeExecuted;
+      std::vector<Statistic<uint64_t> *> opcodeDispatchToIssue;
+      std::vector<Statistic<uint64_t> *> opcodeIssueToComplete;
+  } statistics_;
+
   struct Config {
     bool usePRNG = true;
+    bool modelScalarLoads = true;
   } config;
 
 };
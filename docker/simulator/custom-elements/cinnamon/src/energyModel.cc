@@ -0,0 +1,100 @@
+#include "sst/core/sst_config.h"
+
+#include <iomanip>
+#include <sstream>
+
+#include "energyModel.h"
+
+namespace SST {
+namespace Cinnamon {
+
+// Parameter prefix and report name of every unit type with functional units. Base conversion buffers
+// are accounted through their read and write units, memory slots per byte moved and network energy by
+// the CPU
+struct UnitParams {
+    const char * prefix;
+    const char * name;
+};
+static const UnitParams unitParams[] = {
+    {"add", "Add"}, {"mul", "Mul"}, {"ntt", "NTT"}, {"transpose", "Transpose"}, {"rot", "Rot"}, {"evg", "Evg"},
+    {"bcRead", "BC Read"}, {"bcWrite", "BC Write"}, {nullptr, nullptr}, {"rsv", "Rsv"}, {"mod", "Mod"}, {nullptr, nullptr}, {nullptr, nullptr}};
+static_assert(sizeof(unitParams) / sizeof(unitParams[0]) == CinnamonEnergyModel::numUnits);
+
+static constexpr double picoPerMicro = 1e6;
+
+double CinnamonEnergyModel::Energy::dynamic() const {
+    double total = registerFile + memory;
+    for(auto energy: units) {
+        total += energy;
+    }
+    return total;
+}
+
+CinnamonEnergyModel::CinnamonEnergyModel(Params & params) {
+    for(size_t i = 0; i < numUnits; i++) {
+        if(!unitParams[i].prefix) {
+            continue;
+        }
+        std::string prefix(unitParams[i].prefix);
+        issueEnergy[i] = params.find<double>(prefix + "Energy", 0);
+        unitStaticPower[i] = params.find<double>(prefix + "StaticPower", 0);
+    }
+    vectorRegisterReadEnergy = params.find<double>("vectorRegisterReadEnergy", 0);
+    vectorRegisterWriteEnergy = params.find<double>("vectorRegisterWriteEnergy", 0);
+    registerFileStaticPower = params.find<double>("registerFileStaticPower", 0);
+    memoryEnergyPerByte = params.find<double>("memoryEnergyPerByte", 0);
+}
+
+bool CinnamonEnergyModel::configured() const {
+    for(size_t i = 0; i < numUnits; i++) {
+        if(issueEnergy[i] != 0 || unitStaticPower[i] != 0) {
+            return true;
+        }
+    }
+    return vectorRegisterReadEnergy != 0 || vectorRegisterWriteEnergy != 0 || registerFileStaticPower != 0 || memoryEnergyPerByte != 0;
+}
+
+CinnamonEnergyModel::Energy CinnamonEnergyModel::dynamicEnergy(const Activity & activity) const {
+    Energy energy;
+    for(size_t i = 0; i < numUnits; i++) {
+        energy.units[i] = issueEnergy[i] * activity.issueCycles[i];
+    }
+    energy.registerFile = vectorRegisterReadEnergy * activity.vectorRegisterReads + vectorRegisterWriteEnergy * activity.vectorRegisterWrites;
+    energy.memory = memoryEnergyPerByte * activity.memoryBytes;
+    return energy;
+}
+
+double CinnamonEnergyModel::staticPower(const Activity & activity) const {
+    double power = registerFileStaticPower;
+    for(size_t i = 0; i < numUnits; i++) {
+        power += unitStaticPower[i] * activity.instances[i];
+    }
+    return power;
+}
+
+std::string CinnamonEnergyModel::printStats(const Activity & activity, uint64_t nanoSeconds) const {
+    auto energy = dynamicEnergy(activity);
+    double staticEnergy = staticPower(activity) * nanoSeconds;
+    double total = energy.dynamic() + staticEnergy;
+
+    std::stringstream s;
+    s << std::fixed << std::setprecision(3);
+    s << "Energy:\n";
+    for(size_t i = 0; i < numUnits; i++) {
+        if(!unitParams[i].name || activity.instances[i] == 0) {
+            continue;
+        }
+        s << "\t" << unitParams[i].name << ": " << energy.units[i] / picoPerMicro << " uJ dynamic, "
+          << unitStaticPower[i] * activity.instances[i] << " mW static (" << activity.instances[i] << " units)\n";
+    }
+    s << "\tRegister File: " << energy.registerFile / picoPerMicro << " uJ dynamic, " << registerFileStaticPower << " mW static\n";
+    s << "\tMemory: " << energy.memory / picoPerMicro << " uJ\n";
+    s << "\tDynamic Energy: " << energy.dynamic() / picoPerMicro << " uJ\n";
+    s << "\tStatic Energy: " << staticEnergy / picoPerMicro << " uJ\n";
+    s << "\tTotal Energy: " << total / picoPerMicro << " uJ\n";
+    s << "\tAverage Power: " << (nanoSeconds ? total / nanoSeconds : 0.0) << " mW\n";
+    return s.str();
+}
+
+} // Namespace Cinnamon
+} // Namespace SST
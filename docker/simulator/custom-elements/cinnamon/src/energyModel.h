@@ -0,0 +1,63 @@
+#ifndef _H_SST_CINNAMON_ENERGY_MODEL
+#define _H_SST_CINNAMON_ENERGY_MODEL
+
+#include <array>
+#include <string>
+
+#include "sst/core/params.h"
+#include "sst/core/sst_types.h"
+#include "stallStack.h"
+
+namespace SST {
+namespace Cinnamon {
+
+// Energy of a chiplet, computed from the activity counters its units already keep.
+//
+// Dynamic energy is charged per cycle of input issued to a functional unit (one vector of lanes: a
+// column of butterflies on an NTT unit, one of the 16 passes of Rsv and Mod), per vector register read
+// or allocated at dispatch and per byte moved through the memory ports. Static power is drawn by every
+// unit instance and by the register file for the whole simulated time. Energies are in pJ and powers in
+// mW, so energy over a time in ns is a power in mW.
+class CinnamonEnergyModel {
+public:
+    using Unit = CinnamonStallStack::Unit;
+    static constexpr size_t numUnits = static_cast<size_t>(Unit::NUM_UNITS);
+
+    // Counters of a chiplet up to now
+    struct Activity {
+        std::array<uint64_t, numUnits> issueCycles{};
+        std::array<uint32_t, numUnits> instances{};
+        uint64_t vectorRegisterReads = 0;
+        uint64_t vectorRegisterWrites = 0;
+        uint64_t memoryBytes = 0;
+    };
+
+    struct Energy {
+        std::array<double, numUnits> units{};
+        double registerFile = 0;
+        double memory = 0;
+
+        double dynamic() const;
+    };
+
+    explicit CinnamonEnergyModel(Params & params);
+
+    // False when every coefficient is zero. The chiplet then leaves the energy report out
+    bool configured() const;
+    Energy dynamicEnergy(const Activity & activity) const;
+    double staticPower(const Activity & activity) const;
+    std::string printStats(const Activity & activity, uint64_t nanoSeconds) const;
+
+private:
+    std::array<double, numUnits> issueEnergy{}; // pJ per issue cycle
+    std::array<double, numUnits> unitStaticPower{}; // mW per instance
+    double vectorRegisterReadEnergy = 0;
+    double vectorRegisterWriteEnergy = 0;
+    double registerFileStaticPower = 0;
+    double memoryEnergyPerByte = 0;
+};
+
+} // Namespace Cinnamon
+} // Namespace SST
+
+#endif // _H_SST_CINNAMON_ENERGY_MODEL
@@ -0,0 +1,60 @@
+#include "sst/core/sst_config.h"
+
+#include "eventLog.h"
+#include "opcode.h"
+
+namespace SST {
+namespace Cinnamon {
+
+static constexpr size_t bufferedRecords = 1 << 16;
+
+CinnamonEventLog::CinnamonEventLog(const std::string & fileName, SST::Cycle_t start, SST::Cycle_t stop, std::shared_ptr<SST::Output> output) : output(output), start(start), stop(stop) {
+    file.open(fileName, std::ios::binary | std::ios::trunc);
+    if(!file.is_open()) {
+        output->fatal(CALL_INFO, -1, "Unable to open eventLogFile: %s\n", fileName.c_str());
+    }
+    if(stop <= start) {
+        output->fatal(CALL_INFO, -1, "eventLogStop (%" PRIu64 ") must be greater than eventLogStart (%" PRIu64 ")\n", stop, start);
+    }
+    file.write("CNMNEVT1", 8);
+    buffer.reserve(bufferedRecords);
+    for(size_t op = 0; op < static_cast<size_t>(CinnamonInstructionOpCode::NUM_OPCODES); op++) {
+        writeName(Kind::OpCode, 0, NoTrack, op, getOpCodeString(static_cast<CinnamonInstructionOpCode>(op)));
+    }
+}
+
+CinnamonEventLog::~CinnamonEventLog() {
+    flush();
+}
+
+uint32_t CinnamonEventLog::addTrack(uint16_t chiplet, const std::string & name) {
+    auto track = numTracks++;
+    writeName(Kind::Track, chiplet, track, NoOpCode, name);
+    return track;
+}
+
+void CinnamonEventLog::writeName(Kind kind, uint16_t chiplet, uint32_t track, uint8_t opcode, const std::string & name) {
+    // Names are rare, so keep them in order with the records by flushing first
+    flush();
+    Record r{0, 0, name.size(), track, chiplet, static_cast<uint8_t>(kind), opcode};
+    file.write(reinterpret_cast<const char *>(&r), sizeof(r));
+    file.write(name.data(), name.size());
+}
+
+void CinnamonEventLog::record(Kind kind, uint16_t chiplet, uint32_t track, uint64_t id, uint8_t opcode, SST::Cycle_t begin, SST::Cycle_t end) {
+    buffer.push_back({begin, end, id, track, chiplet, static_cast<uint8_t>(kind), opcode});
+    if(buffer.size() == bufferedRecords) {
+        flush();
+    }
+}
+
+void CinnamonEventLog::flush() {
+    if(buffer.empty()) {
+        return;
+    }
+    file.write(reinterpret_cast<const char *>(buffer.data()), buffer.size() * sizeof(Record));
+    buffer.clear();
+}
+
+} // Namespace Cinnamon
+} // Namespace SST
@@ -0,0 +1,74 @@
+#ifndef _H_SST_CINNAMON_EVENT_LOG
+#define _H_SST_CINNAMON_EVENT_LOG
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sst/core/output.h"
+#include "sst/core/sst_types.h"
+
+namespace SST {
+namespace Cinnamon {
+
+// Binary pipeline event log written by CinnamonCPU when eventLogFile is set.
+//
+// The file starts with the 8 byte magic "CNMNEVT1" followed by fixed size records. Track and OpCode
+// records are followed by the name they define (id bytes, not terminated). Only events that start
+// inside [start, stop) are recorded, which bounds the overhead of logging a long run.
+// scripts/cinnamon_timeline.py converts the log to Chrome trace / Perfetto JSON.
+class CinnamonEventLog {
+public:
+    enum class Kind : uint8_t {
+        Track,         // Names track. id is the name length
+        OpCode,        // Names opcode. id is the name length
+        Dispatch,      // Trace instruction id fetched at begin and dispatched at end
+        OperandsReady, // First cycle a queue saw all operands of instruction id ready
+        Reserve,       // Instruction id holds the functional unit on track from begin to end
+        Complete,      // Instruction id wrote its result
+        RegisterFree,  // Physical register id returned to the free list
+        Memory,        // Instruction id occupied the memory request slot on track from begin to end
+        Network        // Instruction id occupied the network port on track from begin to end
+    };
+
+    struct Record {
+        uint64_t begin;
+        uint64_t end;
+        uint64_t id;
+        uint32_t track;
+        uint16_t chiplet;
+        uint8_t kind;
+        uint8_t opcode;
+    };
+    static_assert(sizeof(Record) == 32, "Event log records must stay 32 bytes");
+
+    static constexpr uint32_t NoTrack = static_cast<uint32_t>(-1);
+    static constexpr uint8_t NoOpCode = static_cast<uint8_t>(-1);
+
+    CinnamonEventLog(const std::string & fileName, SST::Cycle_t start, SST::Cycle_t stop, std::shared_ptr<SST::Output> output);
+    ~CinnamonEventLog();
+
+    bool active(SST::Cycle_t cycle) const {
+        return cycle >= start && cycle < stop;
+    }
+
+    uint32_t addTrack(uint16_t chiplet, const std::string & name);
+    void record(Kind kind, uint16_t chiplet, uint32_t track, uint64_t id, uint8_t opcode, SST::Cycle_t begin, SST::Cycle_t end);
+    void flush();
+
+private:
+    std::shared_ptr<SST::Output> output;
+    std::ofstream file;
+    SST::Cycle_t start;
+    SST::Cycle_t stop;
+    uint32_t numTracks = 0;
+    std::vector<Record> buffer;
+
+    void writeName(Kind kind, uint16_t chiplet, uint32_t track, uint8_t opcode, const std::string & name);
+};
+
+} // Namespace Cinnamon
+} // Namespace SST
+
+#endif // _H_SST_CINNAMON_EVENT_LOG
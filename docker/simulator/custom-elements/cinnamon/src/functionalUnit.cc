@@ -3,6 +3,7 @@
 #include "functionalUnit.h"
 #include "chiplet.h"
 #include "CPU.h"
+#include "utils/log.h"
 
 #include<optional>
 
@@ -32,7 +33,7 @@ void CinnamonAddQueue::addToInstructionQueue(std::shared_ptr<CinnamonInstruction
 void CinnamonAddQueue::tick(SST::Cycle_t currentCycle) {
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -41,6 +42,9 @@ void CinnamonAddQueue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
 
             // TODO: Reserve Register File too...
 
@@ -53,16 +57,18 @@ void CinnamonAddQueue::tick(SST::Cycle_t currentCycle) {
                 if(addUnits.at(i)->isIntervalReservable(interval) == true){
                     addUnits.at(i)->addReservation(interval);
                     instructionDispatched = true;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), interval.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), interval.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!instructionDispatched){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Add);
                 return;
             } else {
                 it = instructionQueue.erase(it);
             }
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -93,7 +99,7 @@ void CinnamonMulQueue::addToInstructionQueue(std::shared_ptr<CinnamonInstruction
 void CinnamonMulQueue::tick(SST::Cycle_t currentCycle) {
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -102,6 +108,9 @@ void CinnamonMulQueue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
             SST::Cycle_t start = currentCycle;
             SST::Cycle_t end = currentCycle + VEC_DEPTH - 1 + latency.Mul;
             CinnamonInstructionInterval interval(start,end,instruction);
@@ -111,16 +120,18 @@ void CinnamonMulQueue::tick(SST::Cycle_t currentCycle) {
                 if(mulUnits.at(i)->isIntervalReservable(interval) == true){
                     mulUnits.at(i)->addReservation(interval);
                     instructionDispatched = true;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), interval.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), interval.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!instructionDispatched){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Mul);
                 return;
             } else {
                 it = instructionQueue.erase(it);
             }
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -151,7 +162,7 @@ void CinnamonEvgQueue::addToInstructionQueue(std::shared_ptr<CinnamonInstruction
 void CinnamonEvgQueue::tick(SST::Cycle_t currentCycle) {
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -160,6 +171,9 @@ void CinnamonEvgQueue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
             SST::Cycle_t start = currentCycle;
             SST::Cycle_t end = currentCycle + VEC_DEPTH - 1 + latency.Evg;
             CinnamonInstructionInterval interval(start,end,instruction);
@@ -169,16 +183,18 @@ void CinnamonEvgQueue::tick(SST::Cycle_t currentCycle) {
                 if(evgUnits.at(i)->isIntervalReservable(interval) == true){
                     evgUnits.at(i)->addReservation(interval);
                     instructionDispatched = true;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Evg FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), interval.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Evg FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), interval.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!instructionDispatched){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Evg);
                 return;
             } else {
                 it = instructionQueue.erase(it);
             }
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -211,7 +227,7 @@ void CinnamonRotQueue::tick(SST::Cycle_t currentCycle) {
 
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -220,6 +236,9 @@ void CinnamonRotQueue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
             SST::Cycle_t startRot = currentCycle;
             SST::Cycle_t endRot = startRot + VEC_DEPTH - 1;
             CinnamonInstructionInterval intervalRot(startRot,endRot,instruction);
@@ -227,13 +246,13 @@ void CinnamonRotQueue::tick(SST::Cycle_t currentCycle) {
 
             SST::Cycle_t startTra1 = currentCycle + latency.Rot_one_stage;
             SST::Cycle_t endTra1 = startTra1 + VEC_DEPTH - 1;
-            std::shared_ptr<CinnamonInstruction> nopInstruction1 = std::make_shared<CinnamonNoOpInstruction>();
+            std::shared_ptr<CinnamonInstruction> nopInstruction1 = std::make_shared<CinnamonNoOpInstruction>(*instruction);
             CinnamonInstructionInterval intervalTra1(startTra1,endTra1,nopInstruction1);
 
             SST::Cycle_t startTra2 = currentCycle + latency.Rot_one_stage + latency.Transpose + latency.Rot_one_stage;
             assert(startTra2 > endTra1);
             SST::Cycle_t endTra2 = startTra2 + VEC_DEPTH - 1;
-            std::shared_ptr<CinnamonInstruction> nopInstruction2 = std::make_shared<CinnamonNoOpInstruction>();
+            std::shared_ptr<CinnamonInstruction> nopInstruction2 = std::make_shared<CinnamonNoOpInstruction>(*instruction);
             CinnamonInstructionInterval intervalTra2(startTra2,endTra2,nopInstruction2);
 
             bool instructionDispatched = false;
@@ -241,17 +260,18 @@ void CinnamonRotQueue::tick(SST::Cycle_t currentCycle) {
             for(int i = 0; i < rotUnits.size(); i++){
                 if(rotUnits.at(i)->isIntervalReservable(intervalRot) == true){
                     rotUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Rot FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalRot.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Rot FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalRot.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!rotUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Rot);
                 return;
             }
             for(int i = 0; i < transposeUnits.size(); i++){
                 if(transposeUnits.at(i)->isIntervalReservable(intervalTra1) == true){
                     transposeUnit1ID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTra1.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTra1.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
@@ -261,7 +281,7 @@ void CinnamonRotQueue::tick(SST::Cycle_t currentCycle) {
             for(int i = 0; i < transposeUnits.size(); i++){
                 if(transposeUnits.at(i)->isIntervalReservable(intervalTra2) == true){
                     transposeUnit2ID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTra2.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTra2.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
@@ -274,9 +294,10 @@ void CinnamonRotQueue::tick(SST::Cycle_t currentCycle) {
             selectedRotUnit->addReservation(intervalRot);
             selectedTranspose1Unit->addReservation(intervalTra1);
             selectedTranspose2Unit->addReservation(intervalTra2);
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
             it = instructionQueue.erase(it);
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -309,7 +330,7 @@ void CinnamonNttQueue::tick(SST::Cycle_t currentCycle) {
 
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -318,6 +339,9 @@ void CinnamonNttQueue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
 
             std::optional<int> bcReadUnitID, nttUnitID, transposeUnitID;
 
@@ -333,11 +357,12 @@ void CinnamonNttQueue::tick(SST::Cycle_t currentCycle) {
                 for(int i = 0; i < bcReadUnits.size(); i++){
                     if(bcReadUnits.at(i)->isIntervalReservable(intervalBcRead) == true){
                         bcReadUnitID = i;
-                        output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BcRead FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcRead.getString().c_str(), instruction->getString().c_str(),i);
+                        CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BcRead FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcRead.getString().c_str(), instruction->getString().c_str(),i);
                         break;
                     }
                 }
                 if(!bcReadUnitID.has_value()){
+                    pe->stallStack().unitBusy(CinnamonStallStack::Unit::BcRead);
                     return;
                 }
                 // if (bcReadUnits.at(bcuSrcPhyID)->isIntervalReservable(intervalBcRead) == true){
@@ -355,7 +380,7 @@ void CinnamonNttQueue::tick(SST::Cycle_t currentCycle) {
 
             SST::Cycle_t startTra = startNtt + latency.NTT_one_stage + latency.Mul; // TODO: Set this as the NTT latency
             SST::Cycle_t endTra = startTra + VEC_DEPTH - 1;
-            std::shared_ptr<CinnamonInstruction> nopInstruction = std::make_shared<CinnamonNoOpInstruction>();
+            std::shared_ptr<CinnamonInstruction> nopInstruction = std::make_shared<CinnamonNoOpInstruction>(*instruction);
             CinnamonInstructionInterval intervalTra(startTra,endTra,nopInstruction);
 
 
@@ -378,14 +403,14 @@ void CinnamonNttQueue::tick(SST::Cycle_t currentCycle) {
             for(int i = 0; i < nttUnits.size(); i++){
                 if(nttUnits.at(i)->isIntervalReservable(intervalNtt) == true){
                     nttUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalNtt.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalNtt.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             for(int i = 0; i < transposeUnits.size(); i++){
                 if(transposeUnits.at(i)->isIntervalReservable(intervalTra) == true){
                     transposeUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTra.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTra.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
@@ -407,12 +432,14 @@ void CinnamonNttQueue::tick(SST::Cycle_t currentCycle) {
                 auto selectedTransposeUnit = transposeUnits.at(transposeUnitID.value());
                 selectedNttUnit->addReservation(intervalNtt);
                 selectedTransposeUnit->addReservation(intervalTra);
-                output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
+                CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
                 it = instructionQueue.erase(it);
             } else {
+                pe->stallStack().unitBusy(nttUnitID.has_value() ? CinnamonStallStack::Unit::Transpose : CinnamonStallStack::Unit::Ntt);
                 return;
             }
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -446,7 +473,7 @@ void CinnamonSuDQueue::tick(SST::Cycle_t currentCycle) {
 
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -455,6 +482,9 @@ void CinnamonSuDQueue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
 
             std::optional<int> bcReadUnitID, nttUnitID, transposeUnitID, subUnitID, divUnitID;
 
@@ -470,11 +500,12 @@ void CinnamonSuDQueue::tick(SST::Cycle_t currentCycle) {
                 for(int i = 0; i < bcReadUnits.size(); i++){
                     if(bcReadUnits.at(i)->isIntervalReservable(intervalBcRead) == true){
                         bcReadUnitID = i;
-                        output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BcRead FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcRead.getString().c_str(), instruction->getString().c_str(),i);
+                        CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BcRead FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcRead.getString().c_str(), instruction->getString().c_str(),i);
                         ;
                     }
                 }
                 if(!bcReadUnitID.has_value()){
+                    pe->stallStack().unitBusy(CinnamonStallStack::Unit::BcRead);
                     return;
                 }
                 // if (bcReadUnits.at(bcuSrcPhyID)->isIntervalReservable(intervalBcRead) == true){
@@ -491,7 +522,7 @@ void CinnamonSuDQueue::tick(SST::Cycle_t currentCycle) {
 
             SST::Cycle_t startTranspose = startNtt + latency.NTT_one_stage + latency.Mul; // TODO: Set this as the NTT latency
             SST::Cycle_t endTranspose = startTranspose + VEC_DEPTH - 1;
-            std::shared_ptr<CinnamonInstruction> nopInstruction = std::make_shared<CinnamonNoOpInstruction>();
+            std::shared_ptr<CinnamonInstruction> nopInstruction = std::make_shared<CinnamonNoOpInstruction>(*instruction);
             CinnamonInstructionInterval intervalTranspose(startTranspose,endTranspose,nopInstruction);
 
             SST::Cycle_t startSub = startNtt + latency.NTT;
@@ -507,43 +538,47 @@ void CinnamonSuDQueue::tick(SST::Cycle_t currentCycle) {
             for(int i = 0; i < nttUnits.size(); i++){
                 if(nttUnits.at(i)->isIntervalReservable(intervalNtt) == true){
                     nttUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalNtt.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalNtt.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!nttUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Ntt);
                 return;
             }
             for(int i = 0; i < transposeUnits.size(); i++){
                 if(transposeUnits.at(i)->isIntervalReservable(intervalTranspose) == true){
                     transposeUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!transposeUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Transpose);
                 return;
             }
 
             for(int i = 0; i < addUnits.size(); i++){
                 if(addUnits.at(i)->isIntervalReservable(intervalSub) == true){
                     subUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Add FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalSub.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Add FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalSub.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!subUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Add);
                 return;
             }
 
             for(int i = 0; i < mulUnits.size(); i++){
                 if(mulUnits.at(i)->isIntervalReservable(intervalDiv) == true){
                     divUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Mul FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalDiv.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Mul FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalDiv.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!divUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Mul);
                 return;
             }
 
@@ -574,10 +609,11 @@ void CinnamonSuDQueue::tick(SST::Cycle_t currentCycle) {
             selectedTransposeUnit->addReservation(intervalTranspose);
             selectedSubUnit->addReservation(intervalSub);
             selectedDivUnit->addReservation(intervalDiv);
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
             it = instructionQueue.erase(it);
 
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -612,7 +648,7 @@ void CinnamonBciQueue::tick(SST::Cycle_t currentCycle) {
 
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -622,10 +658,13 @@ void CinnamonBciQueue::tick(SST::Cycle_t currentCycle) {
         auto & instruction = *it;
         bool instructionDispatched = false;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
             for(int i = 0; i < baseConversionUnits.size(); i++){
                 if(baseConversionUnits.at(i)->isBusy() == false){
                     baseConversionUnits.at(i)->initInstruction(currentCycle, instruction);
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu BCI Queue:%s Dispatched Instruction %s to Unit: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu BCI Queue:%s Dispatched Instruction %s to Unit: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str(),i);
                     instructionDispatched = true;
                     break;
                 }
@@ -633,9 +672,11 @@ void CinnamonBciQueue::tick(SST::Cycle_t currentCycle) {
             if(instructionDispatched){
                 it = instructionQueue.erase(it);
             } else {
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Bcu);
                 it++;
             }
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -667,7 +708,7 @@ void CinnamonBcwQueue::tick(SST::Cycle_t currentCycle) {
 
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -676,6 +717,9 @@ void CinnamonBcwQueue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
 
             SST::Cycle_t startBcWrite = currentCycle;
             SST::Cycle_t endBcWrite = startBcWrite + VEC_DEPTH - 1;
@@ -686,12 +730,13 @@ void CinnamonBcwQueue::tick(SST::Cycle_t currentCycle) {
             for(int i = 0; i < bcWriteUnits.size(); i++){
                 if(bcWriteUnits.at(i)->isIntervalReservable(intervalBcWrite) == true){
                     bcWriteUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BcWrite FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcWrite.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BcWrite FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcWrite.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
 
             if(!bcWriteUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::BcWrite);
                 return;
             }
 
@@ -699,9 +744,10 @@ void CinnamonBcwQueue::tick(SST::Cycle_t currentCycle) {
 
 
             selectedBcWriteUnit->addReservation(intervalBcWrite);
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
             it = instructionQueue.erase(it);
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -736,7 +782,7 @@ void CinnamonPl1Queue::tick(SST::Cycle_t currentCycle) {
 
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -745,6 +791,9 @@ void CinnamonPl1Queue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
 
             SST::Cycle_t startIntt = currentCycle;
             SST::Cycle_t endIntt = startIntt + VEC_DEPTH - 1 + latency.NTT_butterfly;
@@ -752,7 +801,7 @@ void CinnamonPl1Queue::tick(SST::Cycle_t currentCycle) {
 
             SST::Cycle_t startTranspose = currentCycle + latency.NTT_one_stage + latency.Mul;
             SST::Cycle_t endTranspose = startTranspose + VEC_DEPTH - 1;
-            std::shared_ptr<CinnamonInstruction> nopInstruction = std::make_shared<CinnamonNoOpInstruction>();
+            std::shared_ptr<CinnamonInstruction> nopInstruction = std::make_shared<CinnamonNoOpInstruction>(*instruction);
             CinnamonInstructionInterval intervalTranspose(startTranspose,endTranspose,nopInstruction);
 
             SST::Cycle_t startBcWrite = currentCycle + latency.NTT;
@@ -764,33 +813,36 @@ void CinnamonPl1Queue::tick(SST::Cycle_t currentCycle) {
             for(int i = 0; i < nttUnits.size(); i++){
                 if(nttUnits.at(i)->isIntervalReservable(intervalIntt) == true){
                     nttUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalIntt.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalIntt.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!nttUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Ntt);
                 return;
             }
             for(int i = 0; i < transposeUnits.size(); i++){
                 if(transposeUnits.at(i)->isIntervalReservable(intervalTranspose) == true){
                     transposeUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!transposeUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Transpose);
                 return;
             }
 
             for(int i = 0; i < bcWriteUnits.size(); i++){
                 if(bcWriteUnits.at(i)->isIntervalReservable(intervalBcWrite) == true){
                     bcWriteUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BcWrite FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcWrite.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BcWrite FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcWrite.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
 
             if(!bcWriteUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::BcWrite);
                 return;
             }
 
@@ -809,9 +861,10 @@ void CinnamonPl1Queue::tick(SST::Cycle_t currentCycle) {
             selectedNttUnit->addReservation(intervalIntt);
             selectedTransposeUnit->addReservation(intervalTranspose);
             selectedBcWriteUnit->addReservation(intervalBcWrite);
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
             it = instructionQueue.erase(it);
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -845,7 +898,7 @@ void CinnamonPl2Queue::tick(SST::Cycle_t currentCycle) {
 
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -856,6 +909,9 @@ void CinnamonPl2Queue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
             SST::Cycle_t startNtt = currentCycle;
             SST::Cycle_t endNtt = startNtt + VEC_DEPTH - 1 + latency.NTT_butterfly;
             CinnamonInstructionInterval intervalNtt(startNtt,endNtt);
@@ -863,7 +919,7 @@ void CinnamonPl2Queue::tick(SST::Cycle_t currentCycle) {
 
             SST::Cycle_t startTranspose1 = currentCycle + latency.NTT_one_stage;
             SST::Cycle_t endTranspose1 = startTranspose1 + VEC_DEPTH - 1;
-            std::shared_ptr<CinnamonInstruction> nopInstruction1 = std::make_shared<CinnamonNoOpInstruction>();
+            std::shared_ptr<CinnamonInstruction> nopInstruction1 = std::make_shared<CinnamonNoOpInstruction>(*instruction);
             CinnamonInstructionInterval intervalTranspose1(startTranspose1,endTranspose1,nopInstruction1);
 
             SST::Cycle_t startMul = currentCycle + latency.NTT;
@@ -876,7 +932,7 @@ void CinnamonPl2Queue::tick(SST::Cycle_t currentCycle) {
 
             SST::Cycle_t startTranspose2 = currentCycle + latency.NTT + latency.Mul + latency.NTT_one_stage;
             SST::Cycle_t endTranspose2 = startTranspose2 + VEC_DEPTH - 1;
-            std::shared_ptr<CinnamonInstruction> nopInstruction2 = std::make_shared<CinnamonNoOpInstruction>();
+            std::shared_ptr<CinnamonInstruction> nopInstruction2 = std::make_shared<CinnamonNoOpInstruction>(*instruction);
             CinnamonInstructionInterval intervalTranspose2(startTranspose2,endTranspose2,nopInstruction2);
 
             // TODO: Change BcWrite to BcRead
@@ -889,17 +945,18 @@ void CinnamonPl2Queue::tick(SST::Cycle_t currentCycle) {
             for(int i = 0; i < nttUnits.size(); i++){
                 if(nttUnits.at(i)->isIntervalReservable(intervalNtt) == true){
                     nttUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalNtt.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalNtt.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!nttUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Ntt);
                 return;
             }
             for(int i = 0; i < transposeUnits.size(); i++){
                 if(transposeUnits.at(i)->isIntervalReservable(intervalTranspose1) == true){
                     transposeUnit1ID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose1.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose1.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
@@ -909,11 +966,12 @@ void CinnamonPl2Queue::tick(SST::Cycle_t currentCycle) {
             for(int i = 0; i < mulUnits.size(); i++){
                 if(mulUnits.at(i)->isIntervalReservable(intervalMul) == true){
                     mulUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Mul FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalMul.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Mul FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalMul.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!mulUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Mul);
                 return;
             }
             for(int i = 0; i < nttUnits.size(); i++){
@@ -922,11 +980,12 @@ void CinnamonPl2Queue::tick(SST::Cycle_t currentCycle) {
                 // }
                 if(nttUnits.at(i)->isIntervalReservable(intervalIntt) == true){
                     inttUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalIntt.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalIntt.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!inttUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Ntt);
                 return;
             }
             for(int i = 0; i < transposeUnits.size(); i++){
@@ -935,7 +994,7 @@ void CinnamonPl2Queue::tick(SST::Cycle_t currentCycle) {
                 // }
                 if(transposeUnits.at(i)->isIntervalReservable(intervalTranspose2) == true){
                     transposeUnit2ID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose2.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose2.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
@@ -948,8 +1007,9 @@ void CinnamonPl2Queue::tick(SST::Cycle_t currentCycle) {
 
             auto bcuDestPhyID = pl2Instruction->getBcDestPhyID();
             if(bcWriteUnits.at(bcuDestPhyID)->isIntervalReservable(intervalBcWrite) == true){
-                output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BC Write FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcWrite.getString().c_str(), instruction->getString().c_str(), bcuDestPhyID);
+                CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BC Write FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcWrite.getString().c_str(), instruction->getString().c_str(), bcuDestPhyID);
             } else {
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::BcWrite);
                 return;
             }
 
@@ -972,10 +1032,11 @@ void CinnamonPl2Queue::tick(SST::Cycle_t currentCycle) {
             selectedInttUnit->addReservation(intervalIntt);
             selectedTranspose2Unit->addReservation(intervalTranspose2);
             selectedBcWriteUnit->addReservation(intervalBcWrite);
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
             it = instructionQueue.erase(it);
 
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -1009,7 +1070,7 @@ void CinnamonPl3Queue::tick(SST::Cycle_t currentCycle) {
 
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -1018,6 +1079,9 @@ void CinnamonPl3Queue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
 
             SST::Cycle_t startMul = currentCycle;
             SST::Cycle_t endMul = startMul + VEC_DEPTH - 1 + latency.Mul;
@@ -1029,7 +1093,7 @@ void CinnamonPl3Queue::tick(SST::Cycle_t currentCycle) {
 
             SST::Cycle_t startTranspose = currentCycle + latency.Mul + latency.NTT_one_stage + latency.Mul;
             SST::Cycle_t endTranspose = startTranspose + VEC_DEPTH - 1;
-            std::shared_ptr<CinnamonInstruction> nopInstruction = std::make_shared<CinnamonNoOpInstruction>();
+            std::shared_ptr<CinnamonInstruction> nopInstruction = std::make_shared<CinnamonNoOpInstruction>(*instruction);
             CinnamonInstructionInterval intervalTranspose(startTranspose,endTranspose,nopInstruction);
 
             SST::Cycle_t startBcWrite = currentCycle + latency.NTT + latency.Mul;
@@ -1042,42 +1106,46 @@ void CinnamonPl3Queue::tick(SST::Cycle_t currentCycle) {
             for(int i = 0; i < mulUnits.size(); i++){
                 if(mulUnits.at(i)->isIntervalReservable(intervalMul) == true){
                     mulUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Mul FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalMul.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Mul FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalMul.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!mulUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Mul);
                 return;
             }
             for(int i = 0; i < nttUnits.size(); i++){
                 if(nttUnits.at(i)->isIntervalReservable(intervalIntt) == true){
                     inttUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalIntt.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalIntt.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!inttUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Ntt);
                 return;
             }
             for(int i = 0; i < transposeUnits.size(); i++){
                 if(transposeUnits.at(i)->isIntervalReservable(intervalTranspose) == true){
                     transposeUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!transposeUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Transpose);
                 return;
             }
 
             for(int i = 0; i < bcWriteUnits.size(); i++){
                 if(bcWriteUnits.at(i)->isIntervalReservable(intervalBcWrite) == true){
                     bcWriteUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BcWrite FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcWrite.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BcWrite FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcWrite.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!bcWriteUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::BcWrite);
                 return;
             }
 
@@ -1099,10 +1167,11 @@ void CinnamonPl3Queue::tick(SST::Cycle_t currentCycle) {
             selectedInttUnit->addReservation(intervalIntt);
             selectedTransposeUnit->addReservation(intervalTranspose);
             selectedBcWriteUnit->addReservation(intervalBcWrite);
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
             it = instructionQueue.erase(it);
 
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -1136,7 +1205,7 @@ void CinnamonPl4Queue::tick(SST::Cycle_t currentCycle) {
 
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -1145,6 +1214,9 @@ void CinnamonPl4Queue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
 
             SST::Cycle_t startBcRead = currentCycle;
             SST::Cycle_t endBcRead = startBcRead + VEC_DEPTH + latency.Bcu_read;
@@ -1156,7 +1228,7 @@ void CinnamonPl4Queue::tick(SST::Cycle_t currentCycle) {
             
             SST::Cycle_t startTranspose = startNtt + latency.NTT_one_stage + latency.Mul;
             SST::Cycle_t endTranspose = startTranspose + 31;
-            std::shared_ptr<CinnamonInstruction> nopInstruction = std::make_shared<CinnamonNoOpInstruction>();
+            std::shared_ptr<CinnamonInstruction> nopInstruction = std::make_shared<CinnamonNoOpInstruction>(*instruction);
             CinnamonInstructionInterval intervalTranspose(startTranspose,endTranspose,nopInstruction);
 
             SST::Cycle_t startMul = startNtt + latency.NTT - latency.Mul;
@@ -1178,61 +1250,67 @@ void CinnamonPl4Queue::tick(SST::Cycle_t currentCycle) {
             assert(pl4Instruction != nullptr);
             auto bcuSrcPhyID = pl4Instruction->getBcSrcPhyID();
             if(bcReadUnits.at(bcuSrcPhyID)->isIntervalReservable(intervalBcRead) == true){
-                output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BC Read FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcRead.getString().c_str(), instruction->getString().c_str(),bcuSrcPhyID);
+                CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BC Read FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcRead.getString().c_str(), instruction->getString().c_str(),bcuSrcPhyID);
             } else {
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::BcRead);
                 return;
             }
 
             for(int i = 0; i < bcReadUnits.size(); i++){
                 if(bcReadUnits.at(i)->isIntervalReservable(intervalBcRead) == true){
                     bcReadUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BC Read FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcRead.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on BC Read FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalBcRead.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!bcReadUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::BcRead);
                 return;
             }
 
             for(int i = 0; i < nttUnits.size(); i++){
                 if(nttUnits.at(i)->isIntervalReservable(intervalNtt) == true){
                     nttUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalNtt.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on NTT FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalNtt.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!nttUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Ntt);
                 return;
             }
             for(int i = 0; i < transposeUnits.size(); i++){
                 if(transposeUnits.at(i)->isIntervalReservable(intervalTranspose) == true){
                     transposeUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Transpose FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalTranspose.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!transposeUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Transpose);
                 return;
             }
             for(int i = 0; i < mulUnits.size(); i++){
                 if(mulUnits.at(i)->isIntervalReservable(intervalMul) == true){
                     mulUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Mul FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalMul.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Mul FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalMul.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!mulUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Mul);
                 return;
             }
 
             for(int i = 0; i < addUnits.size(); i++){
                 if(addUnits.at(i)->isIntervalReservable(intervalSub) == true){
                     subUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Add FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalSub.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Add FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalSub.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!subUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Add);
                 return;
             }
 
@@ -1243,11 +1321,12 @@ void CinnamonPl4Queue::tick(SST::Cycle_t currentCycle) {
                 }
                 if(mulUnits.at(i)->isIntervalReservable(intervalDiv) == true){
                     divUnitID = i;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Mul FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalDiv.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on Mul FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), intervalDiv.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!divUnitID.has_value()){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Mul);
                 return;
             }
 
@@ -1276,10 +1355,11 @@ void CinnamonPl4Queue::tick(SST::Cycle_t currentCycle) {
             selectedMulUnit->addReservation(intervalMul);
             selectedSubUnit->addReservation(intervalSub);
             selectedDivUnit->addReservation(intervalDiv);
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Dispatched Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
             it = instructionQueue.erase(it);
 
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -1312,7 +1392,7 @@ void CinnamonRsvQueue::addToInstructionQueue(std::shared_ptr<CinnamonInstruction
 void CinnamonRsvQueue::tick(SST::Cycle_t currentCycle) {
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -1321,6 +1401,9 @@ void CinnamonRsvQueue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
 
             // TODO: Reserve Register File too...
 
@@ -1333,16 +1416,18 @@ void CinnamonRsvQueue::tick(SST::Cycle_t currentCycle) {
                 if(rsvUnits.at(i)->isIntervalReservable(interval) == true){
                     rsvUnits.at(i)->addReservation(interval);
                     instructionDispatched = true;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), interval.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), interval.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!instructionDispatched){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Rsv);
                 return;
             } else {
                 it = instructionQueue.erase(it);
             }
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -1373,7 +1458,7 @@ void CinnamonModQueue::addToInstructionQueue(std::shared_ptr<CinnamonInstruction
 void CinnamonModQueue::tick(SST::Cycle_t currentCycle) {
     if(instructionQueue.empty()){
         if(QUEUE_EMPTY) {
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
         return;
     }
@@ -1382,6 +1467,9 @@ void CinnamonModQueue::tick(SST::Cycle_t currentCycle) {
     for(;it != instructionQueue.end(); ){
         auto & instruction = *it;
         if(instruction->allOperandsReady()){
+            if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+            }
 
             // TODO: Reserve Register File too...
 
@@ -1394,16 +1482,18 @@ void CinnamonModQueue::tick(SST::Cycle_t currentCycle) {
                 if(modUnits.at(i)->isIntervalReservable(interval) == true){
                     modUnits.at(i)->addReservation(interval);
                     instructionDispatched = true;
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), interval.getString().c_str(), instruction->getString().c_str(),i);
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Found Reservation Interval %s for Instruction: %s on FU: %d\n", pe->getName().c_str(), currentCycle, name.c_str(), interval.getString().c_str(), instruction->getString().c_str(),i);
                     break;
                 }
             }
             if(!instructionDispatched){
+                pe->stallStack().unitBusy(CinnamonStallStack::Unit::Mod);
                 return;
             } else {
                 it = instructionQueue.erase(it);
             }
         } else {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
             it++;
         }
     }
@@ -1415,9 +1505,14 @@ bool CinnamonModQueue::okayToFinish() {
 
 //###########################################
 
-CinnamonDisQueue::CinnamonDisQueue(CinnamonChiplet * pe, CinnamonCPU * cpu, const std::string & name, const uint32_t outputLevel, CinnamonNetwork * network, Link * networkLink) : pe(pe), cpu(cpu), network(network), networkLink(networkLink), name(name), syncRegistered(false), CinnamonInstructionQueue() {
+CinnamonDisQueue::CinnamonDisQueue(CinnamonChiplet * pe, CinnamonCPU * cpu, const std::string & name, const uint32_t outputLevel, CinnamonNetwork * network, Link * networkLink, size_t maxInFlight) : CinnamonInstructionQueue(), network(network), networkLink(networkLink), pe(pe), cpu(cpu), name(name), maxInFlight(maxInFlight) {
 	output = std::make_shared<SST::Output>(SST::Output(name + "[@p:@l]: ", outputLevel, 0, SST::Output::STDOUT));
     networkLink->setFunctor(new Event::Handler<CinnamonDisQueue>(this,&CinnamonDisQueue::handle_incoming));
+    statistics_.busyCycles = pe->registerUnitStatistic("network_busy_cycles");
+    statistics_.waitingForNetworkCycles = pe->registerUnitStatistic("network_wait_cycles");
+    statistics_.backPressureCycles = pe->registerUnitStatistic("network_backpressure_cycles");
+    statistics_.issuedOutOfOrder = pe->registerUnitStatistic("network_issued_out_of_order");
+    statistics_.latency = pe->registerUnitStatistic("network_latency");
 }
 
 void CinnamonDisQueue::addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) {
@@ -1427,6 +1522,7 @@ void CinnamonDisQueue::addToInstructionQueue(std::shared_ptr<CinnamonInstruction
         case OpCode::Rcv:
         case OpCode::Dis:
         case OpCode::Joi:
+        case OpCode::A2a:
             break;
         default:
             assert(0);
@@ -1438,63 +1534,102 @@ void CinnamonDisQueue::handle_dis(std::shared_ptr<CinnamonDisInstruction> & inst
     auto networkEvent = std::make_unique<CinnamonNetworkEvent>(instruction->syncID());
     networkLink->send(networkEvent.release());
     instruction->setExecutionComplete();
-    busyWith = nullptr;
-    syncRegistered = false;
+    pe->instructionCompleted(*instruction);
 }
 
 void CinnamonDisQueue::handle_joi(std::shared_ptr<CinnamonDisInstruction> & instruction) {
     auto networkEvent = std::make_unique<CinnamonNetworkEvent>(instruction->syncID());
     if(instruction->hasSource() == true){
         networkLink->send(networkEvent.release());
-        output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Sending to network instruction: %s\n", pe->getName().c_str(), cpu->getCurrentSimTime(), name.c_str(),busyWith->getString().c_str());
+        CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Sending to network instruction: %s\n", pe->getName().c_str(), cpu->getCurrentSimTime(), name.c_str(),instruction->getString().c_str());
     }
     if(instruction->hasDest() == false){
         // This instruction only sends data on the network, so we can mark the instruction as complete now
         instruction->setExecutionComplete();
-        busyWith = nullptr;
-        syncRegistered = false;
+        pe->instructionCompleted(*instruction);
+    } else {
+        inFlight[instruction->syncID()] = instruction;
     }
 }
 
 void CinnamonDisQueue::handle_incoming(SST::Event * ev) {
     std::unique_ptr<CinnamonNetworkEvent> networkEvent(static_cast<CinnamonNetworkEvent *>(ev));
-    if(!busyWith){
-        output->fatal(CALL_INFO, -1, "%s: %lu Received Spurious Response\n",pe->getName().c_str(),cpu->getCurrentSimTime());
+    auto it = inFlight.find(networkEvent->syncID());
+    if(it == inFlight.end()){
+        output->fatal(CALL_INFO, -1, "%s: %lu Received Spurious Response for syncID: %lu\n",pe->getName().c_str(),cpu->getCurrentSimTime(), networkEvent->syncID());
     }
-    if(networkEvent->syncID() != busyWith->syncID()){
-        output->fatal(CALL_INFO, -1, "%s: %lu Received Response With mismatching syncID. Expected: %lu, Got: %lu\n",pe->getName().c_str(),cpu->getCurrentSimTime(), networkEvent->syncID(),busyWith->syncID());
+    auto & instruction = it->second;
+    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s received Response for instruction: %s\n", pe->getName().c_str(), cpu->getCurrentSimTime(), name.c_str(),instruction->getString().c_str());
+    instruction->setExecutionComplete();
+    pe->instructionCompleted(*instruction);
+    logNetwork(*instruction, pe->currentCycle());
+    inFlight.erase(it);
+}
+
+// Network port occupancy, from issue until the response (or the send for instructions without one)
+void CinnamonDisQueue::logNetwork(const CinnamonDisInstruction & instruction, SST::Cycle_t currentCycle) {
+    auto syncID = instruction.syncID();
+    auto issued = issuedAtCycle.at(syncID);
+    issuedAtCycle.erase(syncID);
+    statistics_.latency->addData(currentCycle - issued);
+    if(!pe->eventLogActive()) {
+        return;
     }
-    output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s received Response for instruction: %s\n", pe->getName().c_str(), cpu->getCurrentSimTime(), name.c_str(),busyWith->getString().c_str());
-    busyWith->setExecutionComplete();
-    busyWith = nullptr;
-    syncRegistered = false;
-
+    pe->logEvent(CinnamonEventLog::Kind::Network, instruction, pe->networkEventTrack(), issued, currentCycle);
+    pe->logIssueEvent(CinnamonEventLog::Kind::Complete, instruction);
 }
 
 void CinnamonDisQueue::tick(SST::Cycle_t currentCycle) {
     stats_.totalCycles++;
     using OpCode = CinnamonInstruction::OpCode;
-    if(busyWith == nullptr){
-        if(instructionQueue.empty()){
-            if(QUEUE_EMPTY) {
-                output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
-            }
-            return;
+    if(!inFlight.empty()){
+        stats_.busyCycles++;
+        statistics_.busyCycles->addData(1);
+    }
+    if(instructionQueue.empty()){
+        if(QUEUE_EMPTY) {
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Empty\n", pe->getName().c_str(), currentCycle, name.c_str());
         }
+        return;
+    }
+    if(inFlight.size() >= maxInFlight){
+        pe->stallStack().unitBusy(CinnamonStallStack::Unit::Network);
+        return;
+    }
 
-        auto it = instructionQueue.begin();
+    // Only the oldest instructions that could be in flight together register and issue
+    size_t window = maxInFlight - inFlight.size();
+    std::set<uint64_t> olderSyncs;
+    bool waitingForNetwork = false;
+    bool olderWaiting = false;
+    auto it = instructionQueue.begin();
+    for(size_t examined = 0; it != instructionQueue.end() && examined < window; examined++) {
 
         auto instruction = std::dynamic_pointer_cast<CinnamonDisInstruction>(*it);
         assert(instruction);
 
-        if(!instruction->allOperandsReady()){
-            return;
-        }
-        
         auto syncID = instruction->syncID();
         auto syncSize = instruction->syncSize();
 
-        if(!syncRegistered){
+        // A sync can only be registered once per chiplet at a time
+        bool blocked = olderSyncs.count(syncID) != 0 || inFlight.count(syncID) != 0;
+        olderSyncs.insert(syncID);
+        if(blocked) {
+            pe->stallStack().unitBusy(CinnamonStallStack::Unit::Network);
+        } else if(!instruction->allOperandsReady()) {
+            pe->stallStack().operandsNotReady(instruction->blockingProducer());
+            blocked = true;
+        }
+        if(blocked){
+            olderWaiting = true;
+            it++;
+            continue;
+        }
+        if(pe->eventLogActive() && instruction->markOperandsReady()) {
+            pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+        }
+
+        if(registeredSyncs.count(syncID) == 0){
             CinnamonNetwork::OpType opType;
             switch (instruction->getOpCode())
             {
@@ -1505,42 +1640,90 @@ void CinnamonDisQueue::tick(SST::Cycle_t currentCycle) {
                 case OpCode::Joi:
                     opType = CinnamonNetwork::OpType::Agg;
                     break;
+                case OpCode::A2a:
+                    opType = CinnamonNetwork::OpType::A2a;
+                    break;
                 default:
                     throw std::runtime_error("Invalid Instruciton for Network : " + instruction->getString());
                     break;
             }
-            syncRegistered = network->tryRegisterSync(pe->chipletID(), syncID, syncSize, opType,instruction->hasDest(),instruction->hasSource());
-            if(syncRegistered){
-                output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Registerd Sync for Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
+            if(network->tryRegisterSync(pe->chipletID(), syncID, syncSize, opType,instruction->hasDest(),instruction->hasSource())){
+                registeredSyncs.insert(syncID);
+                CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Registerd Sync for Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
             }
         }
 
-        bool networkReady = network->networkReady(syncID);
-        if(!networkReady) {
-            stats_.waitingForNetworkCycles++;
-            return;
+        if(registeredSyncs.count(syncID) == 0 || !network->networkReady(syncID)) {
+            pe->stallStack().unitBusy(CinnamonStallStack::Unit::Network);
+            waitingForNetwork = true;
+            olderWaiting = true;
+            it++;
+            continue;
         }
 
-        busyWith = instruction;
+        // Instructions that send a value need an ingress buffer entry in the network
+        bool sends = instruction->getOpCode() == OpCode::Dis || instruction->hasSource();
+        if(sends && !network->tryAcquireCredit(pe->chipletID(), currentCycle)) {
+            stats_.backPressureCycles++;
+            statistics_.backPressureCycles->addData(1);
+            pe->stallStack().unitBusy(CinnamonStallStack::Unit::Network);
+            olderWaiting = true;
+            it++;
+            continue;
+        }
+
+        registeredSyncs.erase(syncID);
         it = instructionQueue.erase(it);
+        pe->stallStack().issued();
+        instruction->markIssued(currentCycle);
+        instruction->markSourcesRead();
+        if(olderWaiting){
+            stats_.issuedOutOfOrder++;
+            statistics_.issuedOutOfOrder->addData(1);
+        }
 
-        output->verbose(CALL_INFO, 4, 0, "%s: %lu Queue:%s Network ready for Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
+        CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Queue:%s Network ready for Instruction: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
         if(instruction->getOpCode() == OpCode::Dis) {
             handle_dis(instruction);
         } else if(instruction->getOpCode() == OpCode::Rcv) {
-            ;
-        } else if(instruction->getOpCode() == OpCode::Joi) {
+            inFlight[syncID] = instruction;
+        } else if(instruction->getOpCode() == OpCode::Joi || instruction->getOpCode() == OpCode::A2a) {
             handle_joi(instruction);
         } else {
             throw std::runtime_error("Invalid OpCode For network instruction: " + instruction->getString());
         }
-    } else if(busyWith != nullptr){
-        stats_.busyCycles++;
+        issuedAtCycle[syncID] = currentCycle;
+        if(inFlight.count(syncID) == 0) {
+            logNetwork(*instruction, currentCycle);
+        }
+        stats_.maxInFlight = std::max(stats_.maxInFlight, inFlight.size());
+        if(inFlight.size() >= maxInFlight){
+            break;
+        }
+    }
+    if(waitingForNetwork) {
+        stats_.waitingForNetworkCycles++;
+        statistics_.waitingForNetworkCycles->addData(1);
     }
 }
 
 bool CinnamonDisQueue::okayToFinish() {
-    return instructionQueue.empty();
+    return instructionQueue.empty() && inFlight.empty();
+}
+
+std::string CinnamonDisQueue::dumpState() const {
+    std::stringstream s;
+    s << describeQueue(name, instructionQueue);
+    s << "\t\tRegistered syncs:";
+    for(auto syncID: registeredSyncs) {
+        s << " " << syncID;
+    }
+    s << "\n";
+    for(auto & [syncID, instruction]: inFlight) {
+        s << "\t\tWaiting for network: " << instruction->getString() << " (syncID " << syncID
+          << ", issued at cycle " << issuedAtCycle.at(syncID) << ")\n";
+    }
+    return s.str();
 }
 
 //###########################################
@@ -1548,8 +1731,10 @@ bool CinnamonDisQueue::okayToFinish() {
 
 
 
-CinnamonFunctionalUnit::CinnamonFunctionalUnit(CinnamonChiplet * pe, const std::string & name, const uint32_t outputLevel, const uint16_t latency, const uint16_t vecDepth) : pe(pe), name(name) , latency(latency) , vecDepth(vecDepth) {
+CinnamonFunctionalUnit::CinnamonFunctionalUnit(CinnamonChiplet * pe, const std::string & name, CinnamonStallStack::Unit unit, const uint32_t outputLevel, const uint16_t latency, const uint16_t vecDepth) : pe(pe), name(name) , unit(unit), latency(latency) , vecDepth(vecDepth) {
 	output = std::make_shared<SST::Output>(SST::Output(name + "[@p:@l]: ", outputLevel, 0, SST::Output::STDOUT));
+    statistics_.busyCycles = pe->registerUnitStatistic("fu_busy_cycles", name);
+    statistics_.issueCycles = pe->registerUnitStatistic("fu_issue_cycles", name);
 }
 
 void CinnamonFunctionalUnit::executeCycleEnd(SST::Cycle_t currentCycle) {
@@ -1558,7 +1743,7 @@ void CinnamonFunctionalUnit::executeCycleEnd(SST::Cycle_t currentCycle) {
 
     if(!inProcess.empty()) {
         stats_.busyCycles++;
-        stats_.busyCyclesWindow++;
+        statistics_.busyCycles->addData(1);
     }
     auto it = busyWith.begin();
     for(;it != busyWith.end();){
@@ -1567,7 +1752,11 @@ void CinnamonFunctionalUnit::executeCycleEnd(SST::Cycle_t currentCycle) {
         cyclesToReady--;
         if(cyclesToReady == 0){
             instruction->setExecutionComplete();
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Instruction: %s is Ready\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str() );
+            pe->instructionCompleted(*instruction);
+            if(pe->eventLogActive()) {
+                pe->logIssueEvent(CinnamonEventLog::Kind::Complete, *instruction);
+            }
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Instruction: %s is Ready\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str() );
             it = busyWith.erase(it);
         } else {
             it++;
@@ -1580,7 +1769,7 @@ void CinnamonFunctionalUnit::executeCycleEnd(SST::Cycle_t currentCycle) {
         auto & cyclesToComplete = it->second;
         cyclesToComplete--;
         if(cyclesToComplete == 0){
-            output->verbose(CALL_INFO, 4, 0, "%s: %lu FU:%s Instruction: %s is Complete\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str() );
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu FU:%s Instruction: %s is Complete\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str() );
             it = inProcess.erase(it);
         } else {
             it++;
@@ -1595,7 +1784,7 @@ void CinnamonFunctionalUnit::executeCycleEnd(SST::Cycle_t currentCycle) {
     // output->verbose(CALL_INFO, 2, 0, "%s: %lu FU:%s Completed Input Cycle for Instruction: %s with Interval: %s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str(),front.getString().c_str());
     if(front.end() == currentCycle){
         reservations.popFront();
-        pe->addBusyCyclesWindow(VEC_DEPTH);
+        pe->addComputeBusyCycles(VEC_DEPTH);
     }
     
 }
@@ -1611,6 +1800,17 @@ void CinnamonFunctionalUnit::addReservation(const CinnamonInstructionInterval &
     auto instruction = interval.value();
     if(reservations.hasOverlap(interval) == false){
         reservations.insert(interval);
+        pe->stallStack().issued();
+        if(instruction) {
+            instruction->markIssued(pe->currentCycle());
+            instruction->markSourcesRead();
+        }
+        if(pe->eventLogActive()) {
+            if(eventTrack == CinnamonEventLog::NoTrack) {
+                eventTrack = pe->addEventTrack(name);
+            }
+            pe->logEvent(CinnamonEventLog::Kind::Reserve, *instruction, eventTrack, interval.start(), interval.end());
+        }
         return;
     }
 
@@ -1619,14 +1819,6 @@ void CinnamonFunctionalUnit::addReservation(const CinnamonInstructionInterval &
 
 void CinnamonFunctionalUnit::executeCycleBegin(SST::Cycle_t currentCycle) {
 
-    if(currentCycle % 100000 == 0){
-        output->verbose(CALL_INFO, 1, 0, "%s:Heartbeat @ %" PRId64 "00K cycles. FU[%s] Util Cycles: %" PRIu64 "\n",pe->getName().c_str(),currentCycle/(100000),pe->getName().c_str(),stats_.busyCyclesWindow);
-        output->verbose(CALL_INFO, 1, 0, "%s:Heartbeat @ %" PRId64 "00K cycles. FU[%s] Issue Cycles: %" PRIu64 "\n",pe->getName().c_str(),currentCycle/(100000),pe->getName().c_str(),stats_.issueCyclesWindow);
-        output->flush();
-        stats_.busyCyclesWindow = 0;
-        stats_.issueCyclesWindow = 0;
-    }
-
     if(consumingCycles != 0) {
         consumingCycles--;
     }
@@ -1648,12 +1840,12 @@ void CinnamonFunctionalUnit::executeCycleBegin(SST::Cycle_t currentCycle) {
 
     
     if(interval.end() < currentCycle){
-        output->verbose(CALL_INFO, 4, 0, "Error: Instruction %s was not issued. Interval: %s. Some thing is terribly wrong\n",instruction->getString().c_str(),interval.getString().c_str());
+        CINNAMON_VERBOSE(output, 4, 0, "Error: Instruction %s was not issued. Interval: %s. Some thing is terribly wrong\n",instruction->getString().c_str(),interval.getString().c_str());
         assert(0);
         output->fatal(CALL_INFO, -1, "Error: Instruction %s was not issued in interval: %s. Some thing is terribly wrong\n",instruction->getString().c_str(),interval.getString().c_str());
     }
 
-    output->verbose(CALL_INFO, 4, 0, "%s: %lu Executing Instruction: %s with Interval: %s\n",
+    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Executing Instruction: %s with Interval: %s\n",
                 pe->getName().c_str(), currentCycle, instruction->getString().c_str(),interval.getString().c_str());
 
 
@@ -1670,7 +1862,7 @@ void CinnamonFunctionalUnit::executeCycleBegin(SST::Cycle_t currentCycle) {
     // stats_.busyCycles += (latency + VEC_DEPTH);
     // stats_.busyCycles += (VEC_DEPTH);
     stats_.issueCycles += (vecDepth);
-    stats_.issueCyclesWindow += (vecDepth);
+    statistics_.issueCycles->addData(vecDepth);
     consumingCycles = (vecDepth);
 
     inProcess.emplace_back(std::make_pair(instruction,latency+VEC_DEPTH-1));
@@ -1698,6 +1890,15 @@ std::string CinnamonFunctionalUnit::printStats() {
     return s.str();
 }
 
+std::string CinnamonFunctionalUnit::dumpState() const {
+    std::stringstream s;
+    s << "\t" << name << ": reservations " << reservations.prettyPrint() << "\n";
+    for(auto & [instruction, cyclesToReady]: busyWith) {
+        s << "\t\tExecuting: " << instruction->getString() << " (ready in " << cyclesToReady << " cycles)\n";
+    }
+    return s.str();
+}
+
 // ####################
 
 CinnamonBaseConversionUnit::CinnamonBaseConversionUnit(CinnamonChiplet * pe, const BaseConversionRegister::PhysicalID_t phyID, const std::string & name, const uint32_t outputLevel, const uint16_t latency) : pe(pe), phyID(phyID), name(name) , latency(latency)  {
@@ -1712,8 +1913,16 @@ void CinnamonBaseConversionUnit::executeCycleEnd(SST::Cycle_t currentCycle) {
 
     auto instruction = busyWith.value();
     if(instruction->isCompleted()){
-        output->verbose(CALL_INFO, 4, 0, "%s: %lu BCU:%s Instruction: %s is Ready\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str() );
+        CINNAMON_VERBOSE(output, 4, 0, "%s: %lu BCU:%s Instruction: %s is Ready\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str() );
         instruction->setExecutionComplete();
+        pe->instructionCompleted(*instruction);
+        if(pe->eventLogActive()) {
+            if(eventTrack == CinnamonEventLog::NoTrack) {
+                eventTrack = pe->addEventTrack(name);
+            }
+            pe->logEvent(CinnamonEventLog::Kind::Reserve, *instruction, eventTrack, busySince, currentCycle);
+            pe->logIssueEvent(CinnamonEventLog::Kind::Complete, *instruction);
+        }
         busyWith.reset();
         return;
     }
@@ -1729,11 +1938,26 @@ bool CinnamonBaseConversionUnit::isBusy() const {
     return busyWith.has_value();
 }
 
+std::string CinnamonBaseConversionUnit::dumpState() const {
+    std::stringstream s;
+    s << "\t" << name << ": ";
+    if(busyWith.has_value()) {
+        s << busyWith.value()->getString() << " since cycle " << busySince;
+    } else {
+        s << "idle";
+    }
+    s << "\n";
+    return s.str();
+}
+
 void CinnamonBaseConversionUnit::initInstruction(SST::Cycle_t currentCycle, std::shared_ptr<CinnamonBciInstruction> instruction) {
     assert(!busyWith.has_value());
     instruction->setPhyiscalBaseConversionRegister(phyID);
     busyWith = instruction;
-    output->verbose(CALL_INFO, 4, 0, "%s: %lu BCU:%s : Initialized with instruction%s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
+    busySince = currentCycle;
+    pe->stallStack().issued();
+    instruction->markIssued(currentCycle);
+    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu BCU:%s : Initialized with instruction%s\n", pe->getName().c_str(), currentCycle, name.c_str(), instruction->getString().c_str());
 }
 
 bool CinnamonBaseConversionUnit::okayToFinish() {
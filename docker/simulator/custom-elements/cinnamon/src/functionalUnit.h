@@ -3,6 +3,9 @@
 
 #include <queue>
 #include <list>
+#include <set>
+#include <map>
+#include <sstream>
 
 #include <sst/core/component.h>
 #include "sst/core/interfaces/stdMem.h"
@@ -11,6 +14,8 @@
 
 #include "network.h"
 #include "latency.h"
+#include "eventLog.h"
+#include "stallStack.h"
 
 
 namespace SST {
@@ -24,6 +29,7 @@ class CinnamonFunctionalUnit {
     CinnamonChiplet * pe;
     std::shared_ptr<SST::Output> output;
     std::string name;
+    CinnamonStallStack::Unit unit;
     // std::queue<std::shared_ptr<CinnamonInstruction>> instructionQueue;
     CinnamonFuDisjointIntervalSet reservations;
     std::list<std::pair<std::shared_ptr<CinnamonInstruction>,SST::Cycle_t>> busyWith;
@@ -34,19 +40,24 @@ class CinnamonFunctionalUnit {
     // std::uint8_t numUnits;
     SST::Cycle_t consumingCycles = 0;
     std::uint16_t vecDepth = 0;
+    uint32_t eventTrack = CinnamonEventLog::NoTrack;
 
     struct Stats {
         SST::Cycle_t busyCycles = 0;
-        SST::Cycle_t busyCyclesWindow = 0;
         SST::Cycle_t issueCycles = 0;
-        SST::Cycle_t issueCyclesWindow = 0;
         SST::Cycle_t totalCycles = 0;
     } stats_;
 
+    // SST statistics, registered on the chiplet with the unit name as subId
+    struct Statistics {
+        Statistic<uint64_t> * busyCycles;
+        Statistic<uint64_t> * issueCycles;
+    } statistics_;
+
     public:
 
     // CinnamonMemoryUnit(Interfaces::StandardMem * memory);
-    CinnamonFunctionalUnit(CinnamonChiplet * pe, const std::string & name, const uint32_t outputLevel, const uint16_t latency, const uint16_t vecDepth);
+    CinnamonFunctionalUnit(CinnamonChiplet * pe, const std::string & name, CinnamonStallStack::Unit unit, const uint32_t outputLevel, const uint16_t latency, const uint16_t vecDepth);
     // void addToQueue(std::shared_ptr<CinnamonInstruction>);
     void executeCycleBegin(SST::Cycle_t currentCycle);
     void executeCycleEnd(SST::Cycle_t currentCycle);
@@ -54,6 +65,10 @@ class CinnamonFunctionalUnit {
     bool isIntervalReservable(const CinnamonInstructionInterval & );
     void addReservation(const CinnamonInstructionInterval & interval);
     std::string printStats();
+    std::string dumpState() const;
+    // Activity counters for the energy model
+    CinnamonStallStack::Unit getUnit() const { return unit; }
+    SST::Cycle_t issueCycles() const { return stats_.issueCycles; }
 
 };
 
@@ -65,6 +80,8 @@ class CinnamonBaseConversionUnit {
     std::string name;
     // std::queue<std::shared_ptr<CinnamonInstruction>> instructionQueue;
     std::optional<std::shared_ptr<CinnamonBciInstruction>> busyWith;
+    SST::Cycle_t busySince = 0;
+    uint32_t eventTrack = CinnamonEventLog::NoTrack;
     // SST::Cycle_t issuedAtCycle;
     std::uint16_t latency;
     // std::uint16_t unitBusyCycles;
@@ -79,6 +96,7 @@ class CinnamonBaseConversionUnit {
     // void assignInstruction(std::shared_ptr<CinnamonBciInstruction> instruction);
     bool isBusy() const;
     void initInstruction(SST::Cycle_t currentCycle, std::shared_ptr<CinnamonBciInstruction> instruction);
+    std::string dumpState() const;
 
 };
 
@@ -89,10 +107,25 @@ class CinnamonInstructionQueue {
         virtual void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) = 0;
         virtual void tick(SST::Cycle_t currentCycle) = 0;
         virtual bool okayToFinish() = 0;
+        // Occupancy and head of the queue for the watchdog state dump
+        virtual std::string dumpState() const = 0;
         virtual ~CinnamonInstructionQueue() = default; 
     protected:
         using FuVector = std::vector<std::shared_ptr<CinnamonFunctionalUnit>>;
         int QUEUE_EMPTY = 0;
+
+        template<class Queue>
+        static std::string describeQueue(const std::string & name, const Queue & queue) {
+            std::stringstream s;
+            s << "\t" << name << ": " << queue.size() << " instructions";
+            if(!queue.empty()) {
+                auto & head = queue.front();
+                s << ", head " << head->getString() << " (trace " << head->getTraceID()
+                  << ", operands " << (head->allOperandsReady() ? "ready" : "not ready") << ")";
+            }
+            s << "\n";
+            return s.str();
+        }
 };
 
 class CinnamonAddQueue : public CinnamonInstructionQueue {
@@ -109,6 +142,9 @@ class CinnamonAddQueue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -127,6 +163,9 @@ class CinnamonMulQueue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -145,6 +184,9 @@ class CinnamonEvgQueue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -167,6 +209,9 @@ class CinnamonRotQueue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -188,6 +233,9 @@ class CinnamonNttQueue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -210,6 +258,9 @@ class CinnamonSuDQueue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -227,6 +278,9 @@ class CinnamonBciQueue: public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -247,6 +301,9 @@ class CinnamonBcwQueue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -266,6 +323,9 @@ class CinnamonPl1Queue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -287,6 +347,9 @@ class CinnamonPl2Queue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -308,6 +371,9 @@ class CinnamonPl3Queue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -330,6 +396,9 @@ class CinnamonPl4Queue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -348,6 +417,9 @@ class CinnamonRsvQueue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -366,6 +438,9 @@ class CinnamonModQueue : public CinnamonInstructionQueue {
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override {
+            return describeQueue(name, instructionQueue);
+        }
 
         // TODO: Add destructor 
 };
@@ -379,26 +454,43 @@ class CinnamonDisQueue : public CinnamonInstructionQueue {
     std::shared_ptr<SST::Output> output;
     std::list<std::shared_ptr<CinnamonInstruction>> instructionQueue;
 
-    bool syncRegistered;
-    std::shared_ptr<CinnamonDisInstruction> busyWith;
+    // Up to maxInFlight network instructions can register their syncs and wait for the network at once.
+    // Instructions may issue out of trace order unless an older one uses the same syncID
+    size_t maxInFlight;
+    std::set<uint64_t> registeredSyncs; // Syncs registered for instructions still in the queue
+    std::map<uint64_t,std::shared_ptr<CinnamonDisInstruction>> inFlight; // Waiting for the network, keyed by syncID
+    std::map<uint64_t,SST::Cycle_t> issuedAtCycle; // Keyed by syncID, for the event log
         
     void handle_dis(std::shared_ptr<CinnamonDisInstruction> & instruction);
     void handle_joi(std::shared_ptr<CinnamonDisInstruction> & instruction);
     void handle_incoming(SST::Event * ev);
+    void logNetwork(const CinnamonDisInstruction & instruction, SST::Cycle_t currentCycle);
 
     struct Stats {
         SST::Cycle_t totalCycles = 0;
         SST::Cycle_t busyCycles = 0;
         SST::Cycle_t waitingForNetworkCycles = 0;
+        size_t maxInFlight = 0;
+        uint64_t issuedOutOfOrder = 0;
+        SST::Cycle_t backPressureCycles = 0;
 
     } stats_;
 
+    struct Statistics {
+        Statistic<uint64_t> * busyCycles;
+        Statistic<uint64_t> * waitingForNetworkCycles;
+        Statistic<uint64_t> * backPressureCycles;
+        Statistic<uint64_t> * issuedOutOfOrder;
+        Statistic<uint64_t> * latency;
+    } statistics_;
+
     public:
 
-        CinnamonDisQueue(CinnamonChiplet * pe, CinnamonCPU * cpu, const std::string & name, const uint32_t outputLevel, CinnamonNetwork * network, Link * networkLink);
+        CinnamonDisQueue(CinnamonChiplet * pe, CinnamonCPU * cpu, const std::string & name, const uint32_t outputLevel, CinnamonNetwork * network, Link * networkLink, size_t maxInFlight);
         void addToInstructionQueue(std::shared_ptr<CinnamonInstruction> instruction) override;
         void tick(SST::Cycle_t currentCycle) override;
         bool okayToFinish() override;
+        std::string dumpState() const override;
 
 
         // TODO: Add destructor 
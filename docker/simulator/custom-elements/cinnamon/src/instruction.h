@@ -7,6 +7,7 @@
 #include "physicalRegister.h"
 #include "baseConversionRegister.h"
 
+#include <optional>
 #include <variant>
 
 
@@ -23,16 +24,94 @@ class CinnamonInstruction {
 	public:
     using OpCode = CinnamonInstructionOpCode;
     using LimbID_t = std::uint16_t;
+    using Producer = CinnamonStallStack::Producer;
 	
     CinnamonInstruction(OpCode opCode): opCode(opCode) {};
 	CinnamonInstruction::OpCode getOpCode() const { return opCode; }
 
     virtual bool allOperandsReady() const = 0;
+    // Producer of the first operand allOperandsReady() waits on, for the stall stack
+    virtual std::optional<Producer> blockingProducer() const { return std::nullopt; }
+    // Called when the instruction issues, so its source registers record their first read
+    virtual void markSourcesRead() const {}
     virtual void setExecutionComplete() = 0;
     virtual std::string getString() const = 0;
     virtual ~CinnamonInstruction() = default;
+
+    // Index in the chiplet's trace of the instruction this one was created for, and the cycle that
+    // instruction was dispatched. The chiplet sets them on the instructions it dispatches, split and
+    // helper instructions take their parent's
+    uint64_t getTraceID() const { return traceID; }
+    SST::Cycle_t getDispatchCycle() const { return dispatchCycle; }
+    void setOrigin(uint64_t id, SST::Cycle_t cycle) {
+        traceID = id;
+        dispatchCycle = cycle;
+    }
+
+    // Returns true the first time it is called, so operand readiness is only logged once
+    bool markOperandsReady() {
+        bool first = !operandsReadyMarked;
+        operandsReadyMarked = true;
+        return first;
+    }
+
+    // First cycle this instruction reserved a unit
+    std::optional<SST::Cycle_t> getIssueCycle() const { return issueCycle; }
+    void markIssued(SST::Cycle_t cycle) {
+        if(!issueCycle.has_value()) {
+            issueCycle = cycle;
+        }
+    }
+
 	protected:
+    void inheritFrom(const CinnamonInstruction & parent) {
+        traceID = parent.traceID;
+        dispatchCycle = parent.dispatchCycle;
+    }
+    // Gives the instructions an instruction is split into its trace ID and dispatch cycle
+    std::vector<std::shared_ptr<CinnamonInstruction>> adopt(std::vector<std::shared_ptr<CinnamonInstruction>> split) const {
+        for(auto & instruction: split) {
+            instruction->inheritFrom(*this);
+        }
+        return split;
+    }
+
+    template<class... Registers>
+    static std::optional<Producer> firstBlocking(const Registers &... registers) {
+        std::optional<Producer> producer;
+        ((producer = producer.has_value() ? producer : blockingProducerOf(registers)), ...);
+        return producer;
+    }
+    template<class Register>
+    static std::optional<Producer> blockingProducerOf(const std::shared_ptr<Register> & reg) {
+        return reg->blockingProducer();
+    }
+    template<class... Registers>
+    static std::optional<Producer> blockingProducerOf(const std::variant<Registers...> & reg) {
+        return std::visit([](const auto & arg){ return arg->blockingProducer(); }, reg);
+    }
+
+    template<class... Registers>
+    static void markRead(const Registers &... registers) {
+        (markReadOf(registers), ...);
+    }
+    static void markReadOf(const std::shared_ptr<PhysicalRegister> & reg) {
+        if(reg){
+            reg->markRead();
+        }
+    }
+    // Base conversion registers have no value lifetime statistics
+    static void markReadOf(const std::shared_ptr<BaseConversionRegister> & /* reg */) {}
+    template<class... Registers>
+    static void markReadOf(const std::variant<Registers...> & reg) {
+        std::visit([](const auto & arg){ markReadOf(arg); }, reg);
+    }
+
 	OpCode opCode;
+    uint64_t traceID = 0;
+    SST::Cycle_t dispatchCycle = 0;
+    std::optional<SST::Cycle_t> issueCycle;
+    bool operandsReadyMarked = false;
 
 };
 
@@ -68,6 +147,12 @@ class CinnamonMemoryInstruction : public CinnamonInstruction {
         return phyReg->getValueReady();
     }
 
+    void markSourcesRead() const override {
+        if(opCode == OpCode::Store || opCode == OpCode::Spill){
+            markRead(phyReg);
+        }
+    }
+
     void setExecutionComplete() override {
         if(opCode != OpCode::Store || opCode != OpCode::Spill){
             phyReg->setValueReady(true);
@@ -126,6 +211,14 @@ class CinnamonBinOpInstruction : public CinnamonInstruction {
         return src1->getValueReady() && src2->getValueReady() ;
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        return firstBlocking(src1, src2);
+    }
+
+    void markSourcesRead() const override {
+        markRead(src1, src2);
+    }
+
     void setExecutionComplete() override {
         src1->decReference();
         src2->decReference();
@@ -160,6 +253,10 @@ class CinnamonBcReadInstruction : public CinnamonInstruction {
         // TODO: Load these operands too
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        return firstBlocking(src1);
+    }
+
     void setExecutionComplete() override {
         src1->executeRead();
         src1->decReference();
@@ -195,6 +292,14 @@ class CinnamonBcWriteInstruction: public CinnamonInstruction {
         // TODO: Load these operands too
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        return firstBlocking(src1);
+    }
+
+    void markSourcesRead() const override {
+        markRead(src1);
+    }
+
     void setExecutionComplete() override {
         src1->decReference();
         dest->executeWrite();
@@ -258,6 +363,14 @@ class CinnamonNttInstruction : public CinnamonInstruction {
         return ready;
         }
 
+    std::optional<Producer> blockingProducer() const override {
+        return firstBlocking(src1);
+    }
+
+    void markSourcesRead() const override {
+        markRead(src1);
+    }
+
     void setExecutionComplete() override {
         std::visit(overloaded{
                             [&](const std::shared_ptr<BaseConversionRegister >&arg){ 
@@ -340,7 +453,7 @@ class CinnamonNttInstruction : public CinnamonInstruction {
                                 split.push_back(nttInstruction);
                             }
                         }, src1);
-        return split;
+        return adopt(split);
     }
 
 };
@@ -382,6 +495,17 @@ class CinnamonInttInstruction : public CinnamonInstruction {
         return ready && src1->getValueReady();
         }
 
+    std::optional<Producer> blockingProducer() const override {
+        if(hasBcDest() && !std::get<std::shared_ptr<BaseConversionRegister>>(dest)->hasPhysicalID()){
+            return Producer::BaseConversion;
+        }
+        return firstBlocking(src1);
+    }
+
+    void markSourcesRead() const override {
+        markRead(src1);
+    }
+
     void setExecutionComplete() override {
         std::visit(overloaded{
                             [&](const std::shared_ptr<BaseConversionRegister >&arg){ 
@@ -455,7 +579,7 @@ class CinnamonInttInstruction : public CinnamonInstruction {
                                 split.push_back(inttInstruction);
                             }
                         }, dest);
-        return split;
+        return adopt(split);
     }
 
 };
@@ -493,6 +617,14 @@ class CinnamonUnOpInstruction : public CinnamonInstruction {
         return src1->getValueReady();
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        return firstBlocking(src1);
+    }
+
+    void markSourcesRead() const override {
+        markRead(src1);
+    }
+
     void setExecutionComplete() override {
         src1->decReference();
         dest->setValueReady(true);
@@ -513,7 +645,9 @@ class CinnamonUnOpInstruction : public CinnamonInstruction {
 class CinnamonNoOpInstruction : public CinnamonInstruction {
 
     public:
-    CinnamonNoOpInstruction() :CinnamonInstruction(OpCode::Nop) {
+    // Reserves a unit on behalf of parent
+    explicit CinnamonNoOpInstruction(const CinnamonInstruction & parent) :CinnamonInstruction(OpCode::Nop) {
+        inheritFrom(parent);
     };
 
     bool allOperandsReady() const override {
@@ -600,6 +734,10 @@ class CinnamonSuDInstruction : public CinnamonInstruction {
         return ready && src1->getValueReady();
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        return firstBlocking(src2, src1);
+    }
+
     void setExecutionComplete() override {
         src1->decReference();
         std::visit(overloaded{
@@ -685,7 +823,7 @@ class CinnamonSuDInstruction : public CinnamonInstruction {
         auto divInstruction = std::make_shared<CinnamonUnOpInstruction>(OpCode::Div,dest,fwReg2,limb);
         fwReg2->incReference();
         split.push_back(divInstruction);
-        return split;
+        return adopt(split);
         
     }
 };
@@ -749,6 +887,17 @@ class CinnamonBcwInstruction : public CinnamonInstruction {
         return dest->hasPhysicalID() && src1->getValueReady();
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        if(!dest->hasPhysicalID()){
+            return Producer::BaseConversion;
+        }
+        return firstBlocking(src1);
+    }
+
+    void markSourcesRead() const override {
+        markRead(src1);
+    }
+
     void setExecutionComplete() override {
         src1->decReference();
         dest->executeWrite();
@@ -786,6 +935,13 @@ class CinnamonPl1Instruction : public CinnamonInstruction {
         return dest->hasPhysicalID() && src1->getValueReady();
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        if(!dest->hasPhysicalID()){
+            return Producer::BaseConversion;
+        }
+        return firstBlocking(src1);
+    }
+
     void setExecutionComplete() override {
         src1->decReference();
         dest->executeWrite();
@@ -811,7 +967,7 @@ class CinnamonPl1Instruction : public CinnamonInstruction {
         auto bcwInstruction = std::make_shared<CinnamonBcWriteInstruction>(OpCode::BcW,dest,fwReg1,limb);
         fwReg1->incReference();
         
-        return std::vector<std::shared_ptr<CinnamonInstruction>>{inttInstruction,bcwInstruction};
+        return adopt({inttInstruction,bcwInstruction});
     }
 
 };
@@ -838,6 +994,13 @@ class CinnamonPl2Instruction : public CinnamonInstruction {
         return dest1->hasPhysicalID() && src1->getValueReady() && src2->getValueReady();
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        if(!dest1->hasPhysicalID()){
+            return Producer::BaseConversion;
+        }
+        return firstBlocking(src1, src2);
+    }
+
     void setExecutionComplete() override {
         src1->executeRead();
         src1->decReference();
@@ -879,7 +1042,7 @@ class CinnamonPl2Instruction : public CinnamonInstruction {
         auto bcwInstruction = std::make_shared<CinnamonBcWriteInstruction>(OpCode::BcW,dest1,fwReg3,limb);
         fwReg3->incReference();
         
-        return std::vector<std::shared_ptr<CinnamonInstruction>>{nttInstruction,mulInstruction,inttInstruction,bcwInstruction};
+        return adopt({nttInstruction,mulInstruction,inttInstruction,bcwInstruction});
     }
 
 };
@@ -905,6 +1068,13 @@ class CinnamonPl3Instruction : public CinnamonInstruction {
         return dest->hasPhysicalID() && src1->getValueReady() && src2->getValueReady();
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        if(!dest->hasPhysicalID()){
+            return Producer::BaseConversion;
+        }
+        return firstBlocking(src1, src2);
+    }
+
     void setExecutionComplete() override {
         src1->decReference();
         src2->decReference();
@@ -936,7 +1106,7 @@ class CinnamonPl3Instruction : public CinnamonInstruction {
         auto bcwInstruction = std::make_shared<CinnamonBcWriteInstruction>(OpCode::BcW,dest,fwReg2,limb);
         fwReg2->incReference();
         
-        return std::vector<std::shared_ptr<CinnamonInstruction>>{mulInstruction,inttInstruction,bcwInstruction};
+        return adopt({mulInstruction,inttInstruction,bcwInstruction});
     }
 
 };
@@ -963,6 +1133,10 @@ class CinnamonPl4Instruction : public CinnamonInstruction {
         return src1->getValueReady() && src2->getValueReady() && src3->getValueReady();
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        return firstBlocking(src1, src2, src3);
+    }
+
     void setExecutionComplete() override {
         src1->executeRead();
         src1->decReference();
@@ -1003,7 +1177,7 @@ class CinnamonPl4Instruction : public CinnamonInstruction {
         auto divInstruction = std::make_shared<CinnamonUnOpInstruction>(OpCode::Div,dest,fwReg4,limb);
         fwReg4->incReference();
         
-        return std::vector<std::shared_ptr<CinnamonInstruction>>{bcrInstruction, nttInstruction, mulInstruction,subInstruction,divInstruction};
+        return adopt({bcrInstruction, nttInstruction, mulInstruction,subInstruction,divInstruction});
     }
 
     BaseConversionRegister::PhysicalID_t getBcSrcPhyID() const {
@@ -1035,6 +1209,17 @@ class CinnamonRsvInstruction : public CinnamonInstruction {
         return src1->getValueReady(); 
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        if(src1 == nullptr){
+            return std::nullopt;
+        }
+        return firstBlocking(src1);
+    }
+
+    void markSourcesRead() const override {
+        markRead(src1);
+    }
+
     void setExecutionComplete() override {
         if(src1){
             src1->decReference();
@@ -1105,6 +1290,21 @@ class CinnamonModInstruction : public CinnamonInstruction {
         return true;
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        for(auto &src: srcs){
+            if(auto producer = src->blockingProducer()){
+                return producer;
+            }
+        }
+        return std::nullopt;
+    }
+
+    void markSourcesRead() const override {
+        for(auto &src: srcs){
+            markRead(src);
+        }
+    }
+
     void setExecutionComplete() override {
         for(auto &src: srcs){
             src->decReference();
@@ -1140,6 +1340,7 @@ class CinnamonDisInstruction : public CinnamonInstruction {
         switch(opCode){ 
             case OpCode::Rcv:
             case OpCode::Dis:
+            case OpCode::A2a:
             break;
             default:
                 throw std::invalid_argument("Invalid Dis Instruction with OpCode : " + getOpCodeString(opCode));
@@ -1156,7 +1357,7 @@ class CinnamonDisInstruction : public CinnamonInstruction {
     };
 
     bool allOperandsReady() const override {
-        if(opCode == OpCode::Dis){
+        if(opCode == OpCode::Dis || opCode == OpCode::A2a){
             return src1->getValueReady();
         } else if(opCode == OpCode::Joi){
             if(src1 != nullptr){
@@ -1169,6 +1370,17 @@ class CinnamonDisInstruction : public CinnamonInstruction {
         return true;
     }
 
+    std::optional<Producer> blockingProducer() const override {
+        if(opCode == OpCode::Rcv || src1 == nullptr){
+            return std::nullopt;
+        }
+        return firstBlocking(src1);
+    }
+
+    void markSourcesRead() const override {
+        markRead(src1);
+    }
+
     void setExecutionComplete() override {
         if(dest != nullptr ){
             dest->setValueReady(true);
@@ -2,13 +2,52 @@
 #include "chiplet.h"
 #include "CPU.h"
 #include "memoryUnit.h"
+#include "simpleHBM.h"
+#include "utils/log.h"
+#include <algorithm>
 
 namespace SST {
 namespace Cinnamon {
 
 // CinnamonCPU::CinnamonMemoryUnit::CinnamonMemoryUnit(Interfaces::StandardMem * memory) : memory(memory), busyWith(nullptr), cyclesToCompletion(0) {};
-CinnamonMemoryUnit::CinnamonMemoryUnit(CinnamonChiplet * pe, CinnamonCPU * cpu, const uint32_t outputLevel, Interfaces::StandardMem * memory, size_t requestWidth) : pe(pe), cpu(cpu), memory(memory), requestWidth(requestWidth) {
+CinnamonMemoryUnit::CinnamonMemoryUnit(CinnamonChiplet * pe, CinnamonCPU * cpu, const uint32_t outputLevel, const std::vector<Interfaces::StandardMem *> & memories, CinnamonAddressMapper * addressMapper, size_t requestWidth, const std::string & portRouting, size_t keyPort, size_t scalarCacheEntries) : pe(pe), cpu(cpu), addressMapper(addressMapper), requestWidth(requestWidth), keyPort(keyPort), scalarCacheEntries(scalarCacheEntries) {
 	output = std::make_shared<SST::Output>(SST::Output("CinnamonMemoryUnit[@p:@l]: ", outputLevel, 0, SST::Output::STDOUT));
+    for(auto memory: memories){
+        ports.emplace_back(memory,NumConcurrentRequests);
+    }
+    if(portRouting == "address"){
+        this->portRouting = PortRouting::Address;
+    } else if(portRouting == "termClass"){
+        this->portRouting = PortRouting::TermClass;
+    } else {
+        output->fatal(CALL_INFO, -1, "Unknown memPortRouting: %s\n", portRouting.c_str());
+    }
+    if(keyPort >= ports.size()){
+        output->fatal(CALL_INFO, -1, "keyMemPort %zu is out of range for %zu memory ports\n", keyPort, ports.size());
+    }
+    stats_.channelBytesRead.resize(addressMapper->numChannels(),0);
+    stats_.channelBytesWritten.resize(addressMapper->numChannels(),0);
+    stats_.channelRequests.resize(addressMapper->numChannels(),0);
+
+    statistics_.busyCycles = pe->registerUnitStatistic("mem_busy_cycles");
+    statistics_.loads = pe->registerUnitStatistic("mem_loads");
+    statistics_.stores = pe->registerUnitStatistic("mem_stores");
+    statistics_.scalarLoads = pe->registerUnitStatistic("mem_scalar_loads");
+    statistics_.scalarCacheHits = pe->registerUnitStatistic("mem_scalar_cache_hits");
+    statistics_.latency = pe->registerUnitStatistic("mem_latency");
+    statistics_.scalarLatency = pe->registerUnitStatistic("mem_scalar_latency");
+    statistics_.storeBufferFullStalls = pe->registerUnitStatistic("store_buffer_full_stalls");
+    statistics_.storesCoalesced = pe->registerUnitStatistic("stores_coalesced");
+    statistics_.spillsElided = pe->registerUnitStatistic("spills_elided");
+    for(size_t channel = 0; channel < addressMapper->numChannels(); channel++){
+        statistics_.channelRequests.push_back(pe->registerUnitStatistic("mem_channel_requests", std::to_string(channel)));
+    }
+    for(size_t portID = 0; portID < ports.size(); portID++){
+        auto & port = ports[portID];
+        port.statistics_.busyCycles = pe->registerUnitStatistic("mem_port_busy_cycles", std::to_string(portID));
+        port.statistics_.bytesRead = pe->registerUnitStatistic("mem_bytes_read", std::to_string(portID));
+        port.statistics_.bytesWritten = pe->registerUnitStatistic("mem_bytes_written", std::to_string(portID));
+    }
     // Interfaces::StandardMem * memory = cpu->loadUserSubComponent<Interfaces::StandardMem>("memory", ComponentInfo::SHARE_NONE, time, new Interfaces::StandardMem::Handler<CinnamonMemoryUnit>(this, &CinnamonMemoryUnit::handleResponse) );
     // if ( !memory ) {
     //     output->fatal(CALL_INFO, -1, "Unable to load memoryInterface subcomponent\n");
@@ -16,13 +55,45 @@ CinnamonMemoryUnit::CinnamonMemoryUnit(CinnamonChiplet * pe, CinnamonCPU * cpu,
 };
 
 void CinnamonMemoryUnit::init(unsigned int phase) {
-    memory->init(phase);
+    for(auto & port: ports){
+        port.memory->init(phase);
+    }
 }
 
 void CinnamonMemoryUnit::setup() {
-    memory->setup();
-    auto lineSize = memory->getLineSize();
-	std::cout << "LineSize: " << lineSize << "\n";
+    for(size_t portID = 0; portID < ports.size(); portID++){
+        auto & port = ports[portID];
+        port.memory->setup();
+        CINNAMON_VERBOSE(output, 1, 0, "Memory port %zu line size: %" PRIu64 "\n", portID, static_cast<uint64_t>(port.memory->getLineSize()));
+    }
+}
+
+void CinnamonMemoryUnit::finish() {
+    for(auto & port: ports){
+        port.memory->finish();
+    }
+}
+
+size_t CinnamonMemoryUnit::routeToPort(Interfaces::StandardMem::Addr addr) const {
+    if(ports.size() == 1){
+        return 0;
+    }
+    size_t limbIndex = addr / addressMapper->limbSize();
+    if(portRouting == PortRouting::TermClass){
+        if(addressMapper->termClass(addr) == CinnamonAddressMapper::TermClass::Key){
+            return keyPort;
+        }
+        // Skip over the key port
+        size_t port = limbIndex % (ports.size() - 1);
+        return (port >= keyPort) ? port + 1 : port;
+    }
+    return limbIndex % ports.size();
+}
+
+bool CinnamonMemoryUnit::waitingForPort(const std::list<std::shared_ptr<CinnamonMemoryInstruction>> & queue, size_t portID) const {
+    return std::any_of(queue.begin(), queue.end(), [&](const std::shared_ptr<CinnamonMemoryInstruction> & instruction) {
+        return routeToPort(instruction->getAddr()) == portID && instruction->allOperandsReady();
+    });
 }
 
 void CinnamonMemoryUnit::addToLoadQueue(std::shared_ptr<CinnamonMemoryInstruction> instruction){
@@ -31,9 +102,65 @@ void CinnamonMemoryUnit::addToLoadQueue(std::shared_ptr<CinnamonMemoryInstructio
 
 void CinnamonMemoryUnit::addToStoreQueue(std::shared_ptr<CinnamonMemoryInstruction> instruction){
     storeQueue.emplace_back(instruction);
+    stats_.maxStoreBufferOccupancy = std::max(stats_.maxStoreBufferOccupancy, storeQueue.size());
+}
+
+void CinnamonMemoryUnit::addToScalarQueue(std::shared_ptr<CinnamonMemoryInstruction> instruction){
+    scalarQueue.emplace_back(instruction);
+}
+
+void CinnamonMemoryUnit::configureStoreBuffer(size_t entries, const std::string & drainPolicy, size_t highWatermark, size_t lowWatermark){
+    storeBufferEntries = entries;
+    if(drainPolicy == "eager"){
+        storeDrainPolicy = StoreDrainPolicy::Eager;
+    } else if(drainPolicy == "loadsFirst"){
+        storeDrainPolicy = StoreDrainPolicy::LoadsFirst;
+    } else if(drainPolicy == "watermark"){
+        storeDrainPolicy = StoreDrainPolicy::Watermark;
+    } else {
+        output->fatal(CALL_INFO, -1, "Unknown storeDrainPolicy: %s\n", drainPolicy.c_str());
+    }
+    storeBufferHighWatermark = highWatermark;
+    storeBufferLowWatermark = lowWatermark;
+    if(storeDrainPolicy == StoreDrainPolicy::Watermark && (highWatermark == 0 || lowWatermark >= highWatermark)){
+        output->fatal(CALL_INFO, -1, "watermark store drain requires 0 <= storeBufferLowWatermark < storeBufferHighWatermark\n");
+    }
+    if(storeBufferEntries != 0 && storeBufferHighWatermark > storeBufferEntries){
+        output->fatal(CALL_INFO, -1, "storeBufferHighWatermark (%zu) must not exceed storeBufferEntries (%zu)\n", storeBufferHighWatermark, storeBufferEntries);
+    }
+}
+
+bool CinnamonMemoryUnit::canAcceptStore(){
+    if(storeBufferEntries == 0 || storeQueue.size() < storeBufferEntries){
+        return true;
+    }
+    stats_.storeBufferFullStalls++;
+    statistics_.storeBufferFullStalls->addData(1);
+    return false;
+}
+
+// Decides whether the store buffer may use request slots this cycle
+bool CinnamonMemoryUnit::storesMayIssue(){
+    bool full = (storeBufferEntries != 0 && storeQueue.size() >= storeBufferEntries);
+    switch(storeDrainPolicy){
+        case StoreDrainPolicy::Eager:
+            return true;
+        case StoreDrainPolicy::LoadsFirst:
+            return full || loadQueue.empty();
+        case StoreDrainPolicy::Watermark:
+            if(storeQueue.size() >= storeBufferHighWatermark){
+                draining = true;
+            } else if(storeQueue.size() <= storeBufferLowWatermark){
+                draining = false;
+            }
+            return draining || loadQueue.empty();
+        default:
+            assert(0);
+    }
+    return true;
 }
 
-std::shared_ptr<PhysicalRegister> CinnamonMemoryUnit::findStoreAlias(Interfaces::StandardMem::Addr addr, bool quashAliasingStore){
+std::shared_ptr<PhysicalRegister> CinnamonMemoryUnit::findStoreAlias(Interfaces::StandardMem::Addr addr, bool quashAliasingStore, bool isLoad){
     std::shared_ptr<PhysicalRegister> aliasPhyReg = nullptr;
     using OpCode = CinnamonInstruction::OpCode;
     auto it = storeQueue.rbegin();
@@ -41,7 +168,7 @@ std::shared_ptr<PhysicalRegister> CinnamonMemoryUnit::findStoreAlias(Interfaces:
         std::shared_ptr<CinnamonMemoryInstruction> instruction = *it;
         if(instruction->getAddr() == addr){
             aliasPhyReg = instruction->getPhyReg();
-            output->verbose(CALL_INFO, 4, 0, "%s: Found Store Alias for addr %" PRIx64 ": %s.\n",
+            CINNAMON_VERBOSE(output, 4, 0, "%s: Found Store Alias for addr %" PRIx64 ": %s.\n",
                         pe->getName().c_str(), addr, instruction->getString().c_str());
 
             // Subsequent loads to the same address can quash aliasing spills
@@ -49,9 +176,18 @@ std::shared_ptr<PhysicalRegister> CinnamonMemoryUnit::findStoreAlias(Interfaces:
             // Instructions must set quashAliasingStore to be true
             if(quashAliasingStore || instruction->getOpCode() == OpCode::Spill ){
                 instruction->quash();
+                if(isLoad){
+                    // The spilled value is reloaded before it reached memory
+                    stats_.spillsElided++;
+                    statistics_.spillsElided->addData(1);
+                } else {
+                    stats_.storesCoalesced++;
+                    statistics_.storesCoalesced->addData(1);
+                }
+                stats_.elidedBytes += instruction->getSize();
                 // instruction->setExecutionComplete();
                 it = decltype(it)(storeQueue.erase( std::next(it).base()));
-                output->verbose(CALL_INFO, 4, 0, "%s: Quashing Store Alias for addr %" PRIx64 ": %s.\n",
+                CINNAMON_VERBOSE(output, 4, 0, "%s: Quashing Store Alias for addr %" PRIx64 ": %s.\n",
                             pe->getName().c_str(), addr, instruction->getString().c_str());
             }
             return aliasPhyReg;
@@ -65,12 +201,21 @@ std::shared_ptr<PhysicalRegister> CinnamonMemoryUnit::findStoreAlias(Interfaces:
 std::shared_ptr<PhysicalRegister> CinnamonMemoryUnit::findLoadAlias(Interfaces::StandardMem::Addr addr){
 
     std::shared_ptr<PhysicalRegister> aliasPhyReg = nullptr;
+    for(auto it = scalarQueue.rbegin(); it != scalarQueue.rend(); it++){
+        std::shared_ptr<CinnamonMemoryInstruction> instruction = *it;
+        if(instruction->getAddr() == addr){
+            aliasPhyReg = instruction->getPhyReg();
+            CINNAMON_VERBOSE(output, 4, 0, "%s: Found Scalar Load Alias for addr %" PRIx64 ": %s.\n",
+                        pe->getName().c_str(), addr, instruction->getString().c_str());
+            return aliasPhyReg;
+        }
+    }
     auto it = loadQueue.rbegin();
     for(; it != loadQueue.rend(); it++){
         std::shared_ptr<CinnamonMemoryInstruction> instruction = *it;
         if(instruction->getAddr() == addr){
             aliasPhyReg = instruction->getPhyReg();
-            output->verbose(CALL_INFO, 4, 0, "%s: Found Load Alias for addr %" PRIx64 ": %s.\n",
+            CINNAMON_VERBOSE(output, 4, 0, "%s: Found Load Alias for addr %" PRIx64 ": %s.\n",
                         pe->getName().c_str(), addr, instruction->getString().c_str());
             return aliasPhyReg;
         }
@@ -79,8 +224,12 @@ std::shared_ptr<PhysicalRegister> CinnamonMemoryUnit::findLoadAlias(Interfaces::
 }
 
 bool CinnamonMemoryUnit::operateQueue(SST::Cycle_t currentCycle, std::list<std::shared_ptr<CinnamonMemoryInstruction>> & queue, const std::string & queueName){
-    for(size_t i = 0; i < NumConcurrentRequests; i++){
+    for(size_t portID = 0; portID < ports.size(); portID++){
+    auto & memRequest = ports[portID].memRequest;
+    bool slotFree = false;
+    for(size_t i = 0; i < memRequest.size(); i++){
     if(memRequest[i].busyWith == nullptr ){
+        slotFree = true;
         if(queue.empty()){
             return false; // nothing to do
         }
@@ -93,164 +242,375 @@ bool CinnamonMemoryUnit::operateQueue(SST::Cycle_t currentCycle, std::list<std::
                 // instruction->quash();
                 // it = storeQueue.erase(it);
             }
+            if(routeToPort(instruction->getAddr()) != portID){
+                it++;
+                continue;
+            }
             if(instruction->allOperandsReady() == true){
+                if(pe->eventLogActive() && instruction->markOperandsReady()) {
+                    pe->logIssueEvent(CinnamonEventLog::Kind::OperandsReady, *instruction);
+                }
 
-                output->verbose(CALL_INFO, 4, 0, "%s: %lu Issuing Instruction: %s\n", pe->getName().c_str(), currentCycle, instruction->getString().c_str() );
+                CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Issuing Instruction on port %zu: %s\n", pe->getName().c_str(), currentCycle, portID, instruction->getString().c_str() );
                 using OpCode = CinnamonInstruction::OpCode;
                 OpCode op = instruction->getOpCode();
                 if(op == OpCode::LoadV){
-                    handleVectorLoad(currentCycle,i,instruction->getAddr(),instruction->getSize());
-                } else if(op == OpCode::LoadS){
-                    handleScalarLoad(currentCycle,instruction->getAddr(),instruction->getSize());
+                    handleVectorLoad(currentCycle,portID,i,instruction->getAddr(),instruction->getSize());
                 } else if(op == OpCode::Store){
-                    handleVectorStore(currentCycle,i,instruction->getAddr(),instruction->getSize());
+                    handleVectorStore(currentCycle,portID,i,instruction->getAddr(),instruction->getSize());
                 } else if(op == OpCode::Spill){
-                    handleVectorStore(currentCycle,i,instruction->getAddr(),instruction->getSize());
+                    handleVectorStore(currentCycle,portID,i,instruction->getAddr(),instruction->getSize());
                 } else {
                     assert(0);
                 }
 
                 memRequest[i].issuedAtCycle = currentCycle;
                 memRequest[i].busyWith = instruction;
+                pe->stallStack().issued();
+                instruction->markIssued(currentCycle);
+                instruction->markSourcesRead();
                 memRequest[i].responseReceived = false;
                 it = queue.erase(it);
                 break;
             } else {
+                pe->stallStack().operandsNotReady(instruction->blockingProducer());
                 it++;
-                output->verbose(CALL_INFO, 4, 0, "%s: %lu: %s Waiting for values to be ready. Skipping Ahead: %s\n",
+                CINNAMON_VERBOSE(output, 4, 0, "%s: %lu: %s Waiting for values to be ready. Skipping Ahead: %s\n",
                             pe->getName().c_str(), currentCycle, queueName.c_str(), instruction->getString().c_str());
             }
         }
         if(it == queue.end()){
-                    output->verbose(CALL_INFO, 4, 0, "%s: %lu %s No Instrutctions Ready to be Issued:\n",
-                                pe->getName().c_str(), currentCycle, queueName.c_str());
-                    return false;
+                    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu %s No Instrutctions Ready to be Issued on port %zu:\n",
+                                pe->getName().c_str(), currentCycle, queueName.c_str(), portID);
+                    break;
         }
     }
     }
+    if(!slotFree && waitingForPort(queue, portID)){
+        pe->stallStack().unitBusy(CinnamonStallStack::Unit::MemorySlot);
+    }
+    }
     return true;
 
 }
 
+void CinnamonMemoryUnit::operateScalarQueue(SST::Cycle_t currentCycle){
+    for(size_t portID = 0; portID < ports.size(); portID++){
+        auto & scalarRequest = ports[portID].scalarRequest;
+        for(auto it = scalarQueue.begin(); it != scalarQueue.end() && scalarRequest.busyWith == nullptr;){
+            std::shared_ptr<CinnamonMemoryInstruction> instruction = *it;
+            if(routeToPort(instruction->getAddr()) != portID){
+                it++;
+                continue;
+            }
+            auto cacheIt = std::find(scalarCache.begin(), scalarCache.end(), instruction->getAddr());
+            if(cacheIt != scalarCache.end()){
+                // Scalar cache hit, the value is available without going to memory
+                scalarCache.splice(scalarCache.begin(), scalarCache, cacheIt);
+                stats_.scalarCacheHits++;
+                statistics_.scalarCacheHits->addData(1);
+                pe->stallStack().issued();
+                instruction->markIssued(currentCycle);
+                instruction->setExecutionComplete();
+                pe->instructionCompleted(*instruction);
+                CINNAMON_VERBOSE(output, 3, 0, "%s: [Time: %" PRIu64 "] Scalar Cache Hit. Completed Instruction: %s\n",
+                            pe->getName().c_str(), currentCycle, instruction->getString().c_str());
+                it = scalarQueue.erase(it);
+                continue;
+            }
+            CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Issuing Instruction on port %zu: %s\n", pe->getName().c_str(), currentCycle, portID, instruction->getString().c_str() );
+            handleScalarLoad(currentCycle,portID,instruction->getAddr(),instruction->getSize());
+            scalarRequest.issuedAtCycle = currentCycle;
+            scalarRequest.busyWith = instruction;
+            pe->stallStack().issued();
+            instruction->markIssued(currentCycle);
+            scalarRequest.responseReceived = false;
+            it = scalarQueue.erase(it);
+        }
+        if(scalarRequest.busyWith != nullptr && waitingForPort(scalarQueue, portID)){
+            pe->stallStack().unitBusy(CinnamonStallStack::Unit::MemorySlot);
+        }
+    }
+}
+
 void CinnamonMemoryUnit::executeCycleBegin(SST::Cycle_t currentCycle) {
     bool busy = false;
-    operateQueue(currentCycle,loadQueue,"loadQueue");
-    operateQueue(currentCycle,storeQueue,"storeQueue");
+    operateScalarQueue(currentCycle);
+    if(storesMayIssue()){
+        if(draining){
+            // Drain a burst of stores ahead of loads to avoid turning the bus around on every request
+            operateQueue(currentCycle,storeQueue,"storeQueue");
+            operateQueue(currentCycle,loadQueue,"loadQueue");
+        } else {
+            operateQueue(currentCycle,loadQueue,"loadQueue");
+            operateQueue(currentCycle,storeQueue,"storeQueue");
+        }
+    } else {
+        operateQueue(currentCycle,loadQueue,"loadQueue");
+    }
     stats_.totalCycles++;
-    for(size_t i = 0; i < NumConcurrentRequests; i++){
-        if(memRequest[i].busyWith != nullptr){
+    for(auto & port: ports){
+        bool portBusy = (port.scalarRequest.busyWith != nullptr);
+        for(auto & memRequest: port.memRequest){
+            if(memRequest.busyWith != nullptr){
+                portBusy = true;
+            }
+        }
+        if(portBusy){
+            port.stats_.busyCycles++;
+            port.statistics_.busyCycles->addData(1);
             busy = true;
         }
     }
     if(busy) {
         stats_.busyCycles++;
-        stats_.busyCyclesWindow++;
+        statistics_.busyCycles->addData(1);
     }
+}
 
-    if(currentCycle % 100000 == 0){
-        output->verbose(CALL_INFO, 1, 0, "%s:Heartbeat @ %" PRId64 "00K cycles. Memory Util Cycles: %" PRIu64 "\n",pe->getName().c_str(),currentCycle/(100000),stats_.busyCyclesWindow);
-        output->flush();
-        stats_.busyCyclesWindow = 0;
+void CinnamonMemoryUnit::logCompletion(MemRequest & memRequest, const std::string & slotName, SST::Cycle_t currentCycle) {
+    if(memRequest.eventTrack == CinnamonEventLog::NoTrack) {
+        memRequest.eventTrack = pe->addEventTrack(slotName);
     }
+    pe->logEvent(CinnamonEventLog::Kind::Memory, *memRequest.busyWith, memRequest.eventTrack, memRequest.issuedAtCycle, currentCycle);
+    pe->logIssueEvent(CinnamonEventLog::Kind::Complete, *memRequest.busyWith);
 }
 
 void CinnamonMemoryUnit::executeCycleEnd(SST::Cycle_t currentCycle) {
 
-    for(size_t i = 0; i < NumConcurrentRequests; i++){
-        if(memRequest[i].responseReceived){
-            memRequest[i].busyWith->setExecutionComplete();
-            output->verbose(CALL_INFO, 3, 0, "%s: [Time: %" PRIu64 "] Completed Instruction: %s\n",
-                        pe->getName().c_str(), currentCycle, memRequest[i].busyWith->getString().c_str());
-            memRequest[i].busyWith = nullptr;
-            memRequest[i].responseReceived = false;
+    for(size_t portID = 0; portID < ports.size(); portID++){
+    auto & port = ports[portID];
+    for(size_t i = 0; i < port.memRequest.size(); i++){
+        auto & memRequest = port.memRequest[i];
+        if(memRequest.responseReceived){
+            memRequest.busyWith->setExecutionComplete();
+            pe->instructionCompleted(*memRequest.busyWith);
+            if(pe->eventLogActive()) {
+                logCompletion(memRequest, "memPort" + std::to_string(portID) + ".slot" + std::to_string(i), currentCycle);
+            }
+            CINNAMON_VERBOSE(output, 3, 0, "%s: [Time: %" PRIu64 "] Completed Instruction: %s\n",
+                        pe->getName().c_str(), currentCycle, memRequest.busyWith->getString().c_str());
+            memRequest.busyWith = nullptr;
+            memRequest.responseReceived = false;
+        }
+    }
+    auto & scalarRequest = port.scalarRequest;
+    if(scalarRequest.responseReceived){
+        if(scalarCacheEntries > 0){
+            scalarCache.push_front(scalarRequest.busyWith->getAddr());
+            if(scalarCache.size() > scalarCacheEntries){
+                scalarCache.pop_back();
+            }
+        }
+        scalarRequest.busyWith->setExecutionComplete();
+        pe->instructionCompleted(*scalarRequest.busyWith);
+        if(pe->eventLogActive()) {
+            logCompletion(scalarRequest, "memPort" + std::to_string(portID) + ".scalar", currentCycle);
         }
+        CINNAMON_VERBOSE(output, 3, 0, "%s: [Time: %" PRIu64 "] Completed Instruction: %s\n",
+                    pe->getName().c_str(), currentCycle, scalarRequest.busyWith->getString().c_str());
+        scalarRequest.busyWith = nullptr;
+        scalarRequest.responseReceived = false;
+    }
     }
 }
 
-void CinnamonMemoryUnit::handleResponse(SST::Interfaces::StandardMem::Request *response_ptr){
+void CinnamonMemoryUnit::handleResponse(SST::Interfaces::StandardMem::Request *response_ptr, size_t portID){
 	std::unique_ptr<Interfaces::StandardMem::Request> response(response_ptr);
     // std::map<uint64_t, SimTime_t>::iterator i = requests.find(response->getID());
+    auto & outstandingRequestID = ports.at(portID).outstandingRequestID;
     auto it = outstandingRequestID.find(response->getID());
     MemRequest * memReq = nullptr;
     if ( it == outstandingRequestID.end() ) {
-        output->fatal(CALL_INFO, -1, "Event (%" PRIx64 ") not found!\n", response->getID());
+        output->fatal(CALL_INFO, -1, "Event (%" PRIx64 ") not found on port %zu!\n", response->getID(), portID);
     } else {
-        memReq = it->second;
-        memReq->bytesProcessed += requestWidth;
+        memReq = it->second.first;
+        memReq->bytesProcessed += it->second.second;
         outstandingRequestID.erase(it);
         SimTime_t et = cpu->getCurrentSimTime() - memReq->issuedAtCycle;
-        output->verbose(CALL_INFO, 5, 0, "%s: Received Response: %lu [Time: %" PRIu64 "] [%zu outstanding requests]\n",
+        CINNAMON_VERBOSE(output, 5, 0, "%s: Received Response: %lu [Time: %" PRIu64 "] [%zu outstanding requests]\n",
                     pe->getName().c_str(), response->getID(), et, loadQueue.size() + storeQueue.size());
     }
     if(memReq->bytesProcessed >= memReq->requestSize){
         memReq->responseReceived = true;
         SimTime_t et = cpu->getCurrentSimTime() - memReq->issuedAtCycle;
-        stats_.totalLatency += et;
-        if(et > stats_.maxLatency) {
-            stats_.maxLatency = et;
+        if(memReq->busyWith->getOpCode() == CinnamonInstruction::OpCode::LoadS) {
+            SST::Cycle_t latency = pe->currentCycle() - memReq->issuedAtCycle;
+            statistics_.scalarLatency->addData(latency);
+            stats_.scalarTotalLatency += latency;
+            if(latency > stats_.scalarMaxLatency) {
+                stats_.scalarMaxLatency = latency;
+            }
+        } else {
+            statistics_.latency->addData(pe->currentCycle() - memReq->issuedAtCycle);
+            stats_.totalLatency += et;
+            if(et > stats_.maxLatency) {
+                stats_.maxLatency = et;
+            }
         }
-        output->verbose(CALL_INFO, 3, 0, "%s: Received Response: [Time: %" PRIu64 "] [%zu outstanding requests]\n",
+        CINNAMON_VERBOSE(output, 3, 0, "%s: Received Response: [Time: %" PRIu64 "] [%zu outstanding requests]\n",
                     pe->getName().c_str(), et, loadQueue.size() + storeQueue.size());
     }
 }
 
-void CinnamonMemoryUnit::handleVectorLoad(SST::Cycle_t currentCycle, size_t memRequestIndex, Interfaces::StandardMem::Addr addr, std::size_t size ) {
-
-    auto memRequestPtr = &(memRequest[memRequestIndex]);
-    for(size_t i = 0; i < size; i+= requestWidth){
-        auto request = std::make_unique<Interfaces::StandardMem::Read>(addr + i, requestWidth);
-        outstandingRequestID[request->getID()] = memRequestPtr;
-        output->verbose(CALL_INFO, 5, 0, "%s: %lu Issued Read for address 0x%" PRIx64 "\n",
-                            pe->getName().c_str(), currentCycle, addr + i);
-        memory->send(request.release());
+void CinnamonMemoryUnit::handleVectorLoad(SST::Cycle_t currentCycle, size_t portID, size_t memRequestIndex, Interfaces::StandardMem::Addr addr, std::size_t size ) {
+
+    auto & port = ports.at(portID);
+    auto memRequestPtr = &(port.memRequest[memRequestIndex]);
+    for(size_t i = 0; i < size; ){
+        auto physAddr = addressMapper->translate(addr + i);
+        auto channel = addressMapper->channel(physAddr);
+        auto width = std::min({requestWidth, size - i, addressMapper->contiguousBytes(addr + i)});
+        stats_.channelBytesRead[channel] += width;
+        stats_.channelRequests[channel]++;
+        statistics_.channelRequests[channel]->addData(1);
+        auto request = std::make_unique<Interfaces::StandardMem::Read>(physAddr, width);
+        port.outstandingRequestID[request->getID()] = {memRequestPtr, width};
+        CINNAMON_VERBOSE(output, 5, 0, "%s: %lu Issued Read for address 0x%" PRIx64 " (Physical: 0x%" PRIx64 ", Channel: %zu)\n",
+                            pe->getName().c_str(), currentCycle, addr + i, physAddr, channel);
+        port.memory->send(request.release());
+        i += width;
     }
     memRequestPtr->requestSize = size;
     memRequestPtr->bytesProcessed = 0;
+    port.stats_.maxOutstanding = std::max(port.stats_.maxOutstanding,port.outstandingRequestID.size());
+    port.stats_.bytesRead += size;
+    port.statistics_.bytesRead->addData(size);
+    port.stats_.loadsIssued++;
+    if(port.lastWasWrite){
+        port.stats_.turnarounds++;
+        port.lastWasWrite = false;
+    }
     stats_.loadsIssued++;
+    statistics_.loads->addData(1);
 
 }
 
-void CinnamonMemoryUnit::handleVectorStore(SST::Cycle_t currentCycle, size_t memRequestIndex, Interfaces::StandardMem::Addr addr, std::size_t size ) {
+void CinnamonMemoryUnit::handleVectorStore(SST::Cycle_t currentCycle, size_t portID, size_t memRequestIndex, Interfaces::StandardMem::Addr addr, std::size_t size ) {
 
-    auto memRequestPtr = &(memRequest[memRequestIndex]);
-    for(size_t i = 0; i < size; i+=requestWidth){
+    auto & port = ports.at(portID);
+    auto memRequestPtr = &(port.memRequest[memRequestIndex]);
+    for(size_t i = 0; i < size; ){
         std::vector<uint8_t> data;
-        auto request = std::make_unique<Interfaces::StandardMem::Write>(addr + i, requestWidth, data);
-        outstandingRequestID[request->getID()] = memRequestPtr;
-        output->verbose(CALL_INFO, 5, 0, "%s: %lu Issued Write for address 0x%" PRIx64 "\n",
-                            pe->getName().c_str(), currentCycle, addr + i);
-        memory->send(request.release());
+        auto physAddr = addressMapper->translate(addr + i);
+        auto channel = addressMapper->channel(physAddr);
+        auto width = std::min({requestWidth, size - i, addressMapper->contiguousBytes(addr + i)});
+        stats_.channelBytesWritten[channel] += width;
+        stats_.channelRequests[channel]++;
+        statistics_.channelRequests[channel]->addData(1);
+        auto request = std::make_unique<Interfaces::StandardMem::Write>(physAddr, width, data);
+        port.outstandingRequestID[request->getID()] = {memRequestPtr, width};
+        CINNAMON_VERBOSE(output, 5, 0, "%s: %lu Issued Write for address 0x%" PRIx64 " (Physical: 0x%" PRIx64 ", Channel: %zu)\n",
+                            pe->getName().c_str(), currentCycle, addr + i, physAddr, channel);
+        port.memory->send(request.release());
+        i += width;
     }
     memRequestPtr->requestSize = size;
     memRequestPtr->bytesProcessed = 0;
+    port.stats_.maxOutstanding = std::max(port.stats_.maxOutstanding,port.outstandingRequestID.size());
+    port.stats_.bytesWritten += size;
+    port.statistics_.bytesWritten->addData(size);
+    port.stats_.storesIssued++;
+    if(!port.lastWasWrite){
+        port.stats_.turnarounds++;
+        port.lastWasWrite = true;
+    }
     stats_.storesIssued++;
+    statistics_.stores->addData(1);
 
 }
 
-void CinnamonMemoryUnit::handleScalarLoad(SST::Cycle_t currentCycle, Interfaces::StandardMem::Addr addr, std::size_t size ) {
-    assert(0);
-	// size_t scalarSize = (1024* 28) / 8; // 3.5 KB
-	// auto request = std::make_unique<Interfaces::StandardMem::Read>(addr, size);
-    // outstandingRequestID.insert(request->getID());
-	// output->verbose(CALL_INFO, 4, 0, "%s: %lu Issued Read for address 0x%" PRIx64 "\n",
-	// 					pe->getName().c_str(), currentCycle, addr);
-	// memory->send(request.release());
+void CinnamonMemoryUnit::handleScalarLoad(SST::Cycle_t currentCycle, size_t portID, Interfaces::StandardMem::Addr addr, std::size_t size ) {
+
+    auto & port = ports.at(portID);
+    auto memRequestPtr = &(port.scalarRequest);
+    for(size_t i = 0; i < size; ){
+        auto physAddr = addressMapper->translate(addr + i);
+        auto channel = addressMapper->channel(physAddr);
+        auto width = std::min({requestWidth, size - i, addressMapper->contiguousBytes(addr + i)});
+        stats_.channelBytesRead[channel] += width;
+        stats_.channelRequests[channel]++;
+        statistics_.channelRequests[channel]->addData(1);
+        auto request = std::make_unique<Interfaces::StandardMem::Read>(physAddr, width);
+        port.outstandingRequestID[request->getID()] = {memRequestPtr, width};
+        CINNAMON_VERBOSE(output, 5, 0, "%s: %lu Issued Scalar Read for address 0x%" PRIx64 " (Physical: 0x%" PRIx64 ", Channel: %zu)\n",
+                            pe->getName().c_str(), currentCycle, addr + i, physAddr, channel);
+        port.memory->send(request.release());
+        i += width;
+    }
+    memRequestPtr->requestSize = size;
+    memRequestPtr->bytesProcessed = 0;
+    port.stats_.maxOutstanding = std::max(port.stats_.maxOutstanding,port.outstandingRequestID.size());
+    port.stats_.bytesRead += size;
+    port.statistics_.bytesRead->addData(size);
+    stats_.scalarLoadsIssued++;
+    statistics_.scalarLoads->addData(1);
 
 }
 
 bool CinnamonMemoryUnit::okayToFinish() {
-    if(!loadQueue.empty() || !storeQueue.empty()){
+    if(!loadQueue.empty() || !storeQueue.empty() || !scalarQueue.empty()){
         return false;
     } else {
-        for(size_t i = 0; i < NumConcurrentRequests; i++){
-            if(memRequest[i].busyWith != nullptr) {
+        for(auto & port: ports){
+            if(port.scalarRequest.busyWith != nullptr) {
                 return false;
             }
+            for(auto & memRequest: port.memRequest){
+                if(memRequest.busyWith != nullptr) {
+                    return false;
+                }
+            }
         }
     }
     return true;
 }
 
+std::string CinnamonMemoryUnit::dumpState() const {
+    std::stringstream s;
+    auto describe = [&s](const char * queueName, const std::list<std::shared_ptr<CinnamonMemoryInstruction>> & queue) {
+        s << "\t" << queueName << ": " << queue.size() << " instructions";
+        if(!queue.empty()) {
+            s << ", head " << queue.front()->getString();
+        }
+        s << "\n";
+    };
+    describe("Load Queue", loadQueue);
+    describe("Store Queue", storeQueue);
+    describe("Scalar Queue", scalarQueue);
+    auto describeRequest = [&s](size_t portID, const std::string & slot, const MemRequest & memRequest) {
+        if(memRequest.busyWith == nullptr) {
+            return;
+        }
+        s << "\tPort " << portID << " " << slot << ": " << memRequest.busyWith->getString()
+          << " issued at cycle " << memRequest.issuedAtCycle << ", " << memRequest.bytesProcessed
+          << " of " << memRequest.requestSize << " bytes completed" << (memRequest.responseReceived ? ", response received" : "") << "\n";
+    };
+    for(size_t portID = 0; portID < ports.size(); portID++) {
+        auto & port = ports[portID];
+        s << "\tPort " << portID << ": " << port.outstandingRequestID.size() << " requests outstanding\n";
+        for(size_t i = 0; i < port.memRequest.size(); i++) {
+            describeRequest(portID, "slot " + std::to_string(i), port.memRequest[i]);
+        }
+        describeRequest(portID, "scalar", port.scalarRequest);
+    }
+    return s.str();
+}
+
+bool CinnamonMemoryUnit::usesSimpleHBM() const {
+    return std::all_of(ports.begin(), ports.end(), [](const MemPort & port) {
+        return dynamic_cast<CinnamonSimpleHBM *>(port.memory) != nullptr;
+    });
+}
+
+uint64_t CinnamonMemoryUnit::bytesTransferred() const {
+    uint64_t bytes = 0;
+    for(auto & port: ports) {
+        bytes += port.stats_.bytesRead + port.stats_.bytesWritten;
+    }
+    return bytes;
+}
+
 std::string CinnamonMemoryUnit::printStats() {
     std::stringstream s;
     s << "Memory Unit\n";
@@ -263,6 +623,38 @@ std::string CinnamonMemoryUnit::printStats() {
     s << "\tMax Latency: " << stats_.maxLatency << "\n";
     double avgLatency = double(stats_.totalLatency) / (stats_.loadsIssued + stats_.storesIssued);
     s << "\tAverage Latency: " << avgLatency << "\n";
+    s << "\tStores Coalesced: " << stats_.storesCoalesced << "\n";
+    s << "\tSpills Elided: " << stats_.spillsElided << "\n";
+    s << "\tElided Bytes: " << stats_.elidedBytes << "\n";
+    s << "\tStore Buffer Max Occupancy: " << stats_.maxStoreBufferOccupancy << "\n";
+    s << "\tStore Buffer Full Stalls: " << stats_.storeBufferFullStalls << "\n";
+    s << "\tScalar Loads Executed: " << stats_.scalarLoadsIssued << "\n";
+    s << "\tScalar Cache Hits: " << stats_.scalarCacheHits << "\n";
+    s << "\tScalar Max Latency: " << stats_.scalarMaxLatency << "\n";
+    s << "\tScalar Average Latency: " << (stats_.scalarLoadsIssued ? double(stats_.scalarTotalLatency) / stats_.scalarLoadsIssued : 0.0) << "\n";
+    for(size_t i = 0; i < ports.size(); i++){
+        auto & portStats = ports[i].stats_;
+        s << "\tPort " << i << " Loads: " << portStats.loadsIssued;
+        s << " Stores: " << portStats.storesIssued;
+        s << " Bytes Read: " << portStats.bytesRead;
+        s << " Bytes Written: " << portStats.bytesWritten;
+        s << " Busy Cycles: " << portStats.busyCycles;
+        s << " Max Outstanding: " << portStats.maxOutstanding;
+        s << " Read/Write Turnarounds: " << portStats.turnarounds << "\n";
+    }
+    s << "\tAddress Map Policy: " << CinnamonAddressMapper::getPolicyString(addressMapper->policy()) << "\n";
+    uint64_t totalChannelBytes = 0;
+    uint64_t maxChannelBytes = 0;
+    for(size_t i = 0; i < addressMapper->numChannels(); i++){
+        auto channelBytes = stats_.channelBytesRead[i] + stats_.channelBytesWritten[i];
+        totalChannelBytes += channelBytes;
+        maxChannelBytes = std::max(maxChannelBytes,channelBytes);
+        s << "\tChannel " << i << " Requests: " << stats_.channelRequests[i];
+        s << " Bytes Read: " << stats_.channelBytesRead[i];
+        s << " Bytes Written: " << stats_.channelBytesWritten[i] << "\n";
+    }
+    double avgChannelBytes = double(totalChannelBytes) / addressMapper->numChannels();
+    s << "\tChannel Imbalance (max/avg): " << (avgChannelBytes > 0 ? maxChannelBytes / avgChannelBytes : 0.0) << "\n";
     return s.str();
 }
 
@@ -7,8 +7,10 @@
 #include <sst/core/component.h>
 #include "sst/core/interfaces/stdMem.h"
 #include "instruction.h"
+#include "eventLog.h"
 #include "utils/utils.h"
 #include "physicalRegister.h"
+#include "addressMapper.h"
 
 namespace SST {
 namespace Cinnamon {
@@ -20,11 +22,32 @@ class CinnamonMemoryUnit {
     std::shared_ptr<SST::Output> output;
     std::list<std::shared_ptr<CinnamonMemoryInstruction>> loadQueue;
     std::list<std::shared_ptr<CinnamonMemoryInstruction>> storeQueue;
-    Interfaces::StandardMem *memory; // Interface to Memory
+    // Scalar loads are small and have their own queue and request slot so they don't wait behind limb transfers
+    std::list<std::shared_ptr<CinnamonMemoryInstruction>> scalarQueue;
+    std::list<Interfaces::StandardMem::Addr> scalarCache; // LRU order, most recent at the front
+    CinnamonAddressMapper * addressMapper;
     // Interfaces::StandardMem::Request::id_t outstandingRequestID;
     size_t requestWidth = 64;
     size_t NumConcurrentRequests = 2;
 
+    enum class PortRouting {
+        Address,  // Limbs are interleaved across ports by logical address
+        TermClass // Keys go to keyPort, ciphertexts are interleaved across the remaining ports
+    } portRouting = PortRouting::Address;
+    size_t keyPort = 0;
+    size_t scalarCacheEntries = 0;
+
+    // Stores and spills are held in storeQueue, which acts as a write-combining store buffer
+    enum class StoreDrainPolicy {
+        Eager,      // Stores take any request slot left over after loads
+        LoadsFirst, // Stores drain only when no loads are waiting, unless the buffer is full
+        Watermark   // Stores drain in bursts between the high and low watermarks to limit read/write turnarounds
+    } storeDrainPolicy = StoreDrainPolicy::Eager;
+    size_t storeBufferEntries = 0; // 0 is unbounded
+    size_t storeBufferHighWatermark = 0;
+    size_t storeBufferLowWatermark = 0;
+    bool draining = false;
+
     struct MemRequest {
         size_t bytesProcessed = 0;
         size_t requestSize = 0;
@@ -32,10 +55,33 @@ class CinnamonMemoryUnit {
         std::uint16_t cyclesToCompletion = 0;
         bool responseReceived = false;
         std::shared_ptr<CinnamonMemoryInstruction> busyWith = nullptr;
-    } memRequest[2];
-
-    std::unordered_map<Interfaces::StandardMem::Request::id_t,MemRequest *> outstandingRequestID;
-
+        uint32_t eventTrack = CinnamonEventLog::NoTrack;
+    };
+
+    struct MemPort {
+        Interfaces::StandardMem *memory; // Interface to Memory
+        std::vector<MemRequest> memRequest;
+        MemRequest scalarRequest;
+        bool lastWasWrite = false;
+        // Slot and bytes of each request sent to memory
+        std::unordered_map<Interfaces::StandardMem::Request::id_t,std::pair<MemRequest *,size_t>> outstandingRequestID;
+        struct Stats {
+            uint64_t loadsIssued = 0;
+            uint64_t storesIssued = 0;
+            uint64_t bytesRead = 0;
+            uint64_t bytesWritten = 0;
+            SST::Cycle_t busyCycles = 0;
+            size_t maxOutstanding = 0;
+            uint64_t turnarounds = 0;
+        } stats_;
+        struct Statistics {
+            Statistic<uint64_t> * busyCycles;
+            Statistic<uint64_t> * bytesRead;
+            Statistic<uint64_t> * bytesWritten;
+        } statistics_;
+        MemPort(Interfaces::StandardMem * memory, size_t numConcurrentRequests) : memory(memory), memRequest(numConcurrentRequests) {};
+    };
+    std::vector<MemPort> ports;
 
 
 
@@ -45,32 +91,75 @@ class CinnamonMemoryUnit {
     struct Stats {
         uint64_t loadsIssued = 0;
         uint64_t storesIssued = 0;
+        uint64_t scalarLoadsIssued = 0;
+        uint64_t scalarCacheHits = 0;
+        SST::Cycle_t scalarTotalLatency = 0;
+        SST::Cycle_t scalarMaxLatency = 0;
+        uint64_t storesCoalesced = 0;
+        uint64_t spillsElided = 0;
+        uint64_t elidedBytes = 0;
+        uint64_t storeBufferFullStalls = 0;
+        size_t maxStoreBufferOccupancy = 0;
         SST::Cycle_t totalCycles = 0;
         SST::Cycle_t busyCycles = 0;
         SST::Cycle_t totalLatency = 0;
         SST::Cycle_t maxLatency = 0;
-        SST::Cycle_t busyCyclesWindow = 0;
+        std::vector<uint64_t> channelBytesRead;
+        std::vector<uint64_t> channelBytesWritten;
+        std::vector<uint64_t> channelRequests;
     } stats_;
 
+    // SST statistics registered on the chiplet. Port statistics use the port and channel statistics the channel as subId
+    struct Statistics {
+        Statistic<uint64_t> * busyCycles;
+        Statistic<uint64_t> * loads;
+        Statistic<uint64_t> * stores;
+        Statistic<uint64_t> * scalarLoads;
+        Statistic<uint64_t> * scalarCacheHits;
+        Statistic<uint64_t> * latency;
+        Statistic<uint64_t> * scalarLatency;
+        Statistic<uint64_t> * storeBufferFullStalls;
+        Statistic<uint64_t> * storesCoalesced;
+        Statistic<uint64_t> * spillsElided;
+        std::vector<Statistic<uint64_t> *> channelRequests;
+    } statistics_;
+
     public:
 
     // CinnamonMemoryUnit(Interfaces::StandardMem * memory);
-    CinnamonMemoryUnit(CinnamonChiplet * pe, CinnamonCPU * cpu, const uint32_t outputLevel, Interfaces::StandardMem * memory, size_t requestWidth);
+    CinnamonMemoryUnit(CinnamonChiplet * pe, CinnamonCPU * cpu, const uint32_t outputLevel, const std::vector<Interfaces::StandardMem *> & memories, CinnamonAddressMapper * addressMapper, size_t requestWidth, const std::string & portRouting, size_t keyPort, size_t scalarCacheEntries);
     std::shared_ptr<PhysicalRegister> findLoadAlias(Interfaces::StandardMem::Addr addr);
-    std::shared_ptr<PhysicalRegister> findStoreAlias(Interfaces::StandardMem::Addr addr, bool quashAliasingStore);
+    std::shared_ptr<PhysicalRegister> findStoreAlias(Interfaces::StandardMem::Addr addr, bool quashAliasingStore, bool isLoad = false);
+    void configureStoreBuffer(size_t entries, const std::string & drainPolicy, size_t highWatermark, size_t lowWatermark);
+    bool canAcceptStore();
+    bool storesMayIssue();
     void addToLoadQueue(std::shared_ptr<CinnamonMemoryInstruction>);
     void addToStoreQueue(std::shared_ptr<CinnamonMemoryInstruction>);
+    void addToScalarQueue(std::shared_ptr<CinnamonMemoryInstruction>);
+    void operateScalarQueue(SST::Cycle_t currentCycle);
     bool operateQueue(SST::Cycle_t currentCycle, std::list<std::shared_ptr<CinnamonMemoryInstruction>> & queue, const std::string & queueName);
     void executeCycleBegin(SST::Cycle_t currentCycle);
     void executeCycleEnd(SST::Cycle_t currentCycle);
     void init(unsigned int phase);
     void setup();
-    void handleResponse(SST::Interfaces::StandardMem::Request *ev);
-    void handleVectorLoad(SST::Cycle_t currentCycle, size_t memRequestIndex, Interfaces::StandardMem::Addr addr, std::size_t size);
-    void handleVectorStore(SST::Cycle_t currentCycle,size_t memRequestIndex,  Interfaces::StandardMem::Addr addr, std::size_t size );
-    void handleScalarLoad(SST::Cycle_t currentCycle, Interfaces::StandardMem::Addr addr, std::size_t size);
+    void finish();
+    void handleResponse(SST::Interfaces::StandardMem::Request *ev, size_t portID);
+    size_t routeToPort(Interfaces::StandardMem::Addr addr) const;
+    // True if a ready instruction in queue is routed to portID, so a full port holds it back
+    bool waitingForPort(const std::list<std::shared_ptr<CinnamonMemoryInstruction>> & queue, size_t portID) const;
+    // Slot occupancy and completion for the pipeline event log
+    void logCompletion(MemRequest & memRequest, const std::string & slotName, SST::Cycle_t currentCycle);
+    void handleVectorLoad(SST::Cycle_t currentCycle, size_t portID, size_t memRequestIndex, Interfaces::StandardMem::Addr addr, std::size_t size);
+    void handleVectorStore(SST::Cycle_t currentCycle, size_t portID, size_t memRequestIndex,  Interfaces::StandardMem::Addr addr, std::size_t size );
+    void handleScalarLoad(SST::Cycle_t currentCycle, size_t portID, Interfaces::StandardMem::Addr addr, std::size_t size);
     bool okayToFinish();
     std::string printStats();
+    // True if every port is backed by the analytical cinnamon.SimpleHBM model
+    bool usesSimpleHBM() const;
+    // Bytes read and written through all ports, for the energy model
+    uint64_t bytesTransferred() const;
+    // Queues and outstanding requests for the watchdog state dump
+    std::string dumpState() const;
 
 };
 } // Namespace Cinnamon
@@ -1,5 +1,6 @@
 #include "network.h"
 #include "CPU.h"
+#include "utils/log.h"
 
 namespace SST {
 namespace Cinnamon {
@@ -13,17 +14,18 @@ CinnamonNetwork::CinnamonNetwork(ComponentId_t id, Params &params, CinnamonCPU *
     auto linkBW = params.find<UnitAlgebra>("linkBW");
     UnitAlgebra limbSize("224KB"); 
     UnitAlgebra outputClock = linkBW / limbSize;
+    limbOutputTime = (outputClock.invert() / UnitAlgebra("1ps")).getRoundedValue();
 
     std::string port_name_base("chiplet_port_");
     for(size_t chipletID = 0; chipletID < numChiplets; chipletID++){
         std::string port_name = port_name_base + std::to_string(chipletID);
-        output->verbose(CALL_INFO, 1, 0, "Configured Link: %s\n", port_name.c_str());
+        CINNAMON_VERBOSE(output, 1, 0, "Configured Link: %s\n", port_name.c_str());
         auto link = configureLink(port_name, new Event::Handler<CinnamonNetwork,int>(this,&CinnamonNetwork::handleInput,chipletID));
         if ( !link) {
             output->fatal(CALL_INFO, -1, "Unable to load chiplet Link for port : %s\n",port_name.c_str());
         }
         chipletLinks.push_back(link);
-        auto outputTimingLink = configureSelfLink("output_timing_" + std::to_string(chipletID), outputClock,
+        auto outputTimingLink = configureSelfLink("output_timing_" + std::to_string(chipletID), "1ps",
                 new Event::Handler<CinnamonNetwork,int>(this,&CinnamonNetwork::handleOutput,chipletID));
         // auto outputTimingLink = configureSelfLink("output_timing_" + std::to_string(chipletID),"1GHz",
         //         new Event::Handler<CinnamonNetwork,int>(this,&CinnamonNetwork::handleOutput,chipletID));
@@ -32,25 +34,105 @@ CinnamonNetwork::CinnamonNetwork(ComponentId_t id, Params &params, CinnamonCPU *
         outputTiming.push_back(outputTimingLink);
     }
 
+    topology = std::make_unique<CinnamonTopology>(params, output, numChiplets);
+    timeBase = getTimeConverter("1ps");
+    broadcastAlgorithm = parseCollectiveAlgorithm(params.find<std::string>("broadcastAlgorithm", "direct"));
+    aggregationAlgorithm = parseCollectiveAlgorithm(params.find<std::string>("aggregationAlgorithm", "direct"));
+    pipelineChunks = params.find<std::size_t>("pipelineChunks", 8);
+    if(pipelineChunks == 0) {
+        output->fatal(CALL_INFO, -1, "pipelineChunks must be non-zero\n");
+    }
+    if(topology->kind() == CinnamonTopology::Kind::Ideal &&
+        (broadcastAlgorithm != CollectiveAlgorithm::Direct || aggregationAlgorithm != CollectiveAlgorithm::Direct)) {
+        output->fatal(CALL_INFO, -1, "Collective algorithms other than direct need an explicit topology\n");
+    }
+    if(topology->reduction() == CinnamonTopology::Reduction::InNetwork && aggregationAlgorithm != CollectiveAlgorithm::Direct) {
+        output->fatal(CALL_INFO, -1, "In-network reduction needs aggregationAlgorithm = direct\n");
+    }
+    CINNAMON_VERBOSE(output, 1, 0, "Broadcast Algorithm: %s, Aggregation Algorithm: %s\n",
+                getCollectiveAlgorithmString(broadcastAlgorithm).c_str(), getCollectiveAlgorithmString(aggregationAlgorithm).c_str());
+    if(topology->kind() != CinnamonTopology::Kind::Ideal) {
+        for(size_t chipletID = 0; chipletID < numChiplets; chipletID++){
+            auto deliveryLink = configureSelfLink("delivery_" + std::to_string(chipletID), "1ps",
+                    new Event::Handler<CinnamonNetwork,int>(this,&CinnamonNetwork::handleDelivery,chipletID));
+            deliveryLinks.push_back(deliveryLink);
+        }
+    }
+
     // TimeConverter *time = registerClock(outputClock, new Clock::Handler<CinnamonNetwork>(this, &CinnamonNetwork::bufferTick));
     outputBWBuffer.resize(numChiplets);
+    pendingOutput.resize(numChiplets);
 
+    ingressBufferEntries = params.find<size_t>("ingressBufferEntries", 0);
+    egressBufferEntries = params.find<size_t>("egressBufferEntries", 0);
+    credits.resize(numChiplets, ingressBufferEntries);
+    portStats_.resize(numChiplets);
+
+    auto syncWindow = params.find<size_t>("syncWindow", 4096);
+    if(syncWindow == 0) {
+        output->fatal(CALL_INFO, -1, "syncWindow must be non-zero\n");
+    }
+    syncTable.resize(syncWindow);
+
+    for(auto op: {OpType::Brc, OpType::Agg, OpType::A2a}) {
+        for(size_t syncSize = 1; syncSize <= numChiplets; syncSize++) {
+            std::string subId = getOpTypeString(op) + "_" + std::to_string(syncSize);
+            syncStatistics[{op, syncSize}] = {
+                registerStatistic<uint64_t>("sync_latency", subId),
+                registerStatistic<uint64_t>("sync_barrier_wait", subId),
+                registerStatistic<uint64_t>("sync_input_wait", subId),
+                registerStatistic<uint64_t>("sync_transfer", subId)};
+        }
+    }
+    busyCyclesStatistic = registerStatistic<uint64_t>("busy_cycles");
+    for(size_t chipletID = 0; chipletID < numChiplets; chipletID++){
+        bytesSent.push_back(registerStatistic<uint64_t>("bytes_sent", std::to_string(chipletID)));
+        bytesReceived.push_back(registerStatistic<uint64_t>("bytes_received", std::to_string(chipletID)));
+    }
+    linkSampleInterval = params.find<SST::Cycle_t>("linkSampleInterval", 10000);
+    if(linkSampleInterval) {
+        for(size_t linkID = 0; linkID < topology->numLinks(); linkID++){
+            linkBusy.push_back(registerStatistic<uint64_t>("link_busy", topology->linkName(linkID)));
+        }
+        linkBusySampled.resize(topology->numLinks(), 0);
+    }
+
+    auto syncTraceFile = params.find<std::string>("syncTraceFile", "");
+    if(!syncTraceFile.empty()) {
+        syncTrace.open(syncTraceFile);
+        if(!syncTrace.is_open()) {
+            output->fatal(CALL_INFO, -1, "Unable to open syncTraceFile: %s\n", syncTraceFile.c_str());
+        }
+        syncTrace << "syncID,op,syncSize,registered_ps,ready_ps,inputs_done_ps,delivered_ps\n";
+    }
 }
 CinnamonNetwork::~CinnamonNetwork() {}
 
 void CinnamonNetwork::init(unsigned int phase) {}
 void CinnamonNetwork::setup() {}
-void CinnamonNetwork::finish() {}
+void CinnamonNetwork::finish() {
+    sampleLinks();
+    if(syncTrace.is_open()) {
+        syncTrace.close();
+    }
+}
 
 bool CinnamonNetwork::tryRegisterSync(size_t ChipletID, uint64_t syncID, uint64_t syncSize, OpType op, bool sendReply /* Does the network need to send you a value */, bool recvValue /* Are you sending a value to the network*/) {
     std::unique_lock lock(mtx);
-    if(syncOps.find(syncID) == syncOps.end()) {
-        if(syncOps.size() > 1){
-            output->verbose(CALL_INFO, 4, 0, "Registered Sync for syncID = %ld. Sync op size: \n", syncID);
+    progress_++;
+    auto found = findSync(syncID);
+    if(found == nullptr) {
+        if(activeSyncs > 1){
+            CINNAMON_VERBOSE(output, 4, 0, "Registered Sync for syncID = %ld. Sync op size: \n", syncID);
         }
-        auto syncOp = SyncOperation(syncID, syncSize, op);
+        auto & syncOp = insertSync(SyncOperation(syncID, syncSize, op));
         syncOp.incrementReadyCount(ChipletID);
-        output->verbose(CALL_INFO, 4, 0, "Registered Sync for syncID = %ld\n", syncID);
+        syncOp.registeredAt = getCurrentSimTime(timeBase);
+        if(syncOp.ready()) {
+            syncOp.readyAt = syncOp.registeredAt;
+            readySyncs++;
+        }
+        CINNAMON_VERBOSE(output, 4, 0, "Registered Sync for syncID = %ld\n", syncID);
         if(recvValue) {
             syncOp.incrementInputsPending();
         }
@@ -60,14 +142,13 @@ bool CinnamonNetwork::tryRegisterSync(size_t ChipletID, uint64_t syncID, uint64_
                 syncOp.setAggregationDestination(ChipletID);
                 // assert(aggregateDestination == -1);
                 // aggregateDestination = ChipletID;
-            } else if(op == OpType::Brc){
+            } else if(op == OpType::Brc || op == OpType::A2a){
                 syncOp.addBroadcastDestination(ChipletID);
             }
         }
-        syncOps[syncID] = std::move(syncOp);
         return true;
     } else {
-        auto & syncOp = syncOps.at(syncID);
+        auto & syncOp = *found;
         if (op != syncOp.operation()) {
             throw std::invalid_argument("Registered operation does not match expected operation");
         }
@@ -75,6 +156,10 @@ bool CinnamonNetwork::tryRegisterSync(size_t ChipletID, uint64_t syncID, uint64_
             throw std::invalid_argument("Registered syncSize does not match expected syncSize");
         }
         syncOp.incrementReadyCount(ChipletID);
+        if(syncOp.ready()) {
+            syncOp.readyAt = getCurrentSimTime(timeBase);
+            readySyncs++;
+        }
         if(recvValue) {
             syncOp.incrementInputsPending();
         }
@@ -82,11 +167,11 @@ bool CinnamonNetwork::tryRegisterSync(size_t ChipletID, uint64_t syncID, uint64_
             syncOp.incrementOutputsPending();
             if(op == OpType::Agg) {
                 syncOp.setAggregationDestination(ChipletID);
-            } else if(op == OpType::Brc){
+            } else if(op == OpType::Brc || op == OpType::A2a){
                 syncOp.addBroadcastDestination(ChipletID);
             }
         }
-        output->verbose(CALL_INFO, 4, 0, "Increment readyCount to %ld for syncID = %ld\n", syncOp.readyCount(),syncID);
+        CINNAMON_VERBOSE(output, 4, 0, "Increment readyCount to %ld for syncID = %ld\n", syncOp.readyCount(),syncID);
         return true;
     }
     return false;
@@ -94,10 +179,11 @@ bool CinnamonNetwork::tryRegisterSync(size_t ChipletID, uint64_t syncID, uint64_
 
 bool CinnamonNetwork::networkReady(uint64_t syncID) const {
     std::shared_lock lock(mtx);
-    if (syncOps.find(syncID) == syncOps.end()) {
+    auto found = findSync(syncID);
+    if (found == nullptr) {
         return false;
-    } 
-    const auto & syncOp = syncOps.at(syncID);
+    }
+    const auto & syncOp = *found;
     assert(syncOp.inputsPending() >= 0);
     assert(syncOp.outputsPending() >= 0);
     bool ready = syncOp.ready();
@@ -108,6 +194,9 @@ bool CinnamonNetwork::networkReady(uint64_t syncID) const {
         } else if(operation == OpType::Agg) {
             assert(syncOp.outputsPending() == 1);
             assert(syncOp.aggregationDestination() != -1);
+        } else if(operation == OpType::A2a) {
+            assert(syncOp.inputsPending() == syncOp.syncSize());
+            assert(syncOp.outputsPending() == syncOp.syncSize());
         }
         // syncOp.computeRoute();
     }
@@ -116,13 +205,15 @@ bool CinnamonNetwork::networkReady(uint64_t syncID) const {
 
 void CinnamonNetwork::handleInput(SST::Event * ev, int portID){
     std::unique_ptr<CinnamonNetworkEvent> networkEvent(static_cast<CinnamonNetworkEvent *>(ev));
+    progress_++;
     auto syncID = networkEvent->syncID();
-    if(syncOps.find(syncID) == syncOps.end()){
+    auto found = findSync(syncID);
+    if(found == nullptr){
         output->fatal(CALL_INFO, -1, "%s: %lu Received Spurious Incoming With mismatching syncID: %lu\n",getName().c_str(),cpu->getCurrentSimTime(), networkEvent->syncID());
         return;
     }
 
-    auto & syncOp = syncOps.at(syncID);
+    auto & syncOp = *found;
     // if(!syncID.has_value()){
     //     output->fatal(CALL_INFO, -1, "%s: %lu Received Spurious Incoming\n",getName().c_str(),cpu->getCurrentSimTime());
     // }
@@ -133,7 +224,17 @@ void CinnamonNetwork::handleInput(SST::Event * ev, int portID){
     assert(syncOp.inputsPending() >= 0);
     // inputsPending--;
     // assert(inputsPending >= 0);
-    output->verbose(CALL_INFO, 1, 4, "%s: %lu Received Incoming with syncID : %lu\n", getName().c_str(), cpu->getCurrentSimCycle(), networkEvent->syncID());
+    CINNAMON_VERBOSE(output, 1, 4, "%s: %lu Received Incoming with syncID : %lu\n", getName().c_str(), cpu->getCurrentSimCycle(), networkEvent->syncID());
+    syncOp.contributions.emplace_back(portID, getCurrentSimTime(timeBase));
+    bytesSent[portID]->addData(limbShare(syncOp));
+    portStats_[portID].bytesSent += limbShare(syncOp);
+    if(syncOp.inputsPending() == 0) {
+        syncOp.inputsDoneAt = getCurrentSimTime(timeBase);
+    }
+    if(topology->kind() != CinnamonTopology::Kind::Ideal) {
+        routeInput(syncOp, syncID, portID);
+        return;
+    }
     if(syncOp.inputsPending() == 0) {
         auto operation = syncOp.operation();
         if(operation == OpType::Brc){
@@ -144,7 +245,7 @@ void CinnamonNetwork::handleInput(SST::Event * ev, int portID){
                 // auto responseEvent = std::make_unique<CinnamonNetworkEvent>(syncID);
                 // TODO: Make buffers here that handle the latency of ops
                 auto outputBWBufferEntry = CinnamonNetworkOutputBWEntry(syncID,224*1024);
-                outputBWBuffer[i].push_back(outputBWBufferEntry);
+                enqueueOutput(i, outputBWBufferEntry);
                 // outputTiming[i]->send(1,responseEvent.release());
             }
         } else if(operation == OpType::Agg) {
@@ -154,7 +255,14 @@ void CinnamonNetwork::handleInput(SST::Event * ev, int portID){
                 // outputTiming[aggregationDestination]->send(1,responseEvent.release());
 
                 auto outputBWBufferEntry = CinnamonNetworkOutputBWEntry(syncID,224*1024);
-                outputBWBuffer[aggregationDestination].push_back(outputBWBufferEntry);
+                enqueueOutput(aggregationDestination, outputBWBufferEntry);
+        } else if(operation == OpType::A2a) {
+            // Every participant receives (n-1)/n of a limb through its own output port
+            auto n = syncOp.broadcastDestinations().size();
+            for(auto &i : syncOp.broadcastDestinations()){
+                auto outputBWBufferEntry = CinnamonNetworkOutputBWEntry(syncID,(224*1024) * (n - 1) / n);
+                enqueueOutput(i, outputBWBufferEntry);
+            }
         } else {
             throw std::runtime_error("Unimplement Network Operation");
         }
@@ -165,20 +273,24 @@ void CinnamonNetwork::handleInput(SST::Event * ev, int portID){
 
 void CinnamonNetwork::handleOutput(SST::Event * ev, int portID){
     std::unique_ptr<CinnamonNetworkEvent> networkEvent(static_cast<CinnamonNetworkEvent *>(ev));
+    progress_++;
     auto syncID = networkEvent->syncID();
-    if(syncOps.find(syncID) == syncOps.end()){
+    auto found = findSync(syncID);
+    if(found == nullptr){
         output->fatal(CALL_INFO, -1, "%s: %lu Received Spurious Incoming With mismatching syncID: %lu\n",getName().c_str(),cpu->getCurrentSimTime(), networkEvent->syncID());
         return;
     }
 
-    auto & syncOp = syncOps.at(syncID);
+    auto & syncOp = *found;
 
-    output->verbose(CALL_INFO, 4, 0, "%s: %lu Outputing syncID : %lu to chiplet: %d\n", getName().c_str(), cpu->getCurrentSimCycle(), networkEvent->syncID(),portID);
+    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Outputing syncID : %lu to chiplet: %d\n", getName().c_str(), cpu->getCurrentSimCycle(), networkEvent->syncID(),portID);
     auto responseEvent = std::make_unique<CinnamonNetworkEvent>(networkEvent->syncID());
 
     auto hops_ = syncOp.computeHops();
     /* -1 because we already counted the latency once while receiving*/
     chipletLinks[portID]->send(hops_ - 1 /*Latency */, responseEvent.release());
+    bytesReceived[portID]->addData(limbShare(syncOp));
+    portStats_[portID].bytesReceived += limbShare(syncOp);
     syncOp.decrementOutputsPending();
     if(syncOp.inputsPending() == 0 && syncOp.outputsPending() == 0){
         completeOperation(syncID);
@@ -191,35 +303,508 @@ void CinnamonNetwork::handleOutput(SST::Event * ev, int portID){
     
 }
 
+void CinnamonNetwork::routeInput(SyncOperation & syncOp, uint64_t syncID, int portID){
+    SimTime_t now = getCurrentSimTime(timeBase);
+    auto operation = syncOp.operation();
+    if(operation == OpType::Brc){
+        if(syncOp.inputsPending() != 0) {
+            return;
+        }
+        std::vector<int> destinations;
+        for(auto &i : syncOp.broadcastDestinations()){
+            if(i != portID){
+                destinations.push_back(i);
+            }
+        }
+        auto arrivals = scheduleBroadcast(portID, destinations, now);
+        for(size_t i = 0; i < destinations.size(); i++){
+            deliveryLinks[destinations[i]]->send(arrivals[i] - now, new CinnamonNetworkEvent(syncID));
+        }
+    } else if(operation == OpType::Agg) {
+        auto aggregationDestination = syncOp.aggregationDestination();
+        assert(aggregationDestination != -1);
+        if(topology->reduction() == CinnamonTopology::Reduction::InNetwork) {
+            if(syncOp.inputsPending() == 0) {
+                syncOp.lastArrival = topology->reserveReduction(aggregationDestination, syncOp.contributions, limbBytes);
+            }
+        } else if(aggregationAlgorithm == CollectiveAlgorithm::Direct) {
+            // Each contribution travels to the destination as soon as it is sent.
+            // The result is delivered when the last contribution has arrived and has been added
+            SimTime_t arrival = topology->reserve(portID, aggregationDestination, limbBytes, now);
+            if(syncOp.contributions.size() == 1) {
+                syncOp.lastArrival = arrival;
+            } else {
+                syncOp.lastArrival = topology->combine(aggregationDestination, syncOp.lastArrival, arrival, limbBytes);
+            }
+        } else if(syncOp.inputsPending() == 0) {
+            syncOp.lastArrival = scheduleAggregation(aggregationDestination, syncOp.contributions);
+        }
+        if(syncOp.inputsPending() == 0) {
+            deliveryLinks[aggregationDestination]->send(std::max(syncOp.lastArrival, now) - now, new CinnamonNetworkEvent(syncID));
+        }
+    } else if(operation == OpType::A2a) {
+        // Each participant sends a 1/n chunk of its limb to every other participant as soon as it is sent.
+        // A participant is done when the last chunk addressed to it has arrived
+        const auto & participants = syncOp.broadcastDestinations();
+        std::size_t chunkBytes = limbBytes / participants.size();
+        for(auto &i : participants){
+            if(i == portID){
+                continue;
+            }
+            SimTime_t arrival = topology->reserve(portID, i, chunkBytes, now);
+            auto & lastArrival = syncOp.arrivals[i];
+            lastArrival = std::max(lastArrival, arrival);
+        }
+        if(syncOp.inputsPending() == 0) {
+            for(auto &i : participants){
+                SimTime_t arrival = std::max(syncOp.arrivals[i], now);
+                deliveryLinks[i]->send(arrival - now, new CinnamonNetworkEvent(syncID));
+            }
+        }
+    } else {
+        throw std::runtime_error("Unimplement Network Operation");
+    }
+}
+
+std::vector<SimTime_t> CinnamonNetwork::scheduleBroadcast(int root, const std::vector<int> & destinations, SimTime_t now){
+    // Participant 0 is the root. t[i] is the time participant i holds the whole limb
+    std::vector<int> p{root};
+    p.insert(p.end(), destinations.begin(), destinations.end());
+    size_t n = p.size();
+    std::vector<SimTime_t> t(n, now);
+
+    switch(broadcastAlgorithm) {
+        case CollectiveAlgorithm::Direct:
+            for(size_t i = 1; i < n; i++) {
+                t[i] = topology->reserve(root, p[i], limbBytes, now);
+            }
+            break;
+        case CollectiveAlgorithm::BinomialTree:
+            for(size_t step = 1; step < n; step <<= 1) {
+                for(size_t i = 0; i < step && i + step < n; i++) {
+                    t[i + step] = topology->reserve(p[i], p[i + step], limbBytes, t[i]);
+                }
+            }
+            break;
+        case CollectiveAlgorithm::Chain: {
+            std::size_t chunkBytes = (limbBytes + pipelineChunks - 1) / pipelineChunks;
+            std::vector<SimTime_t> chunkAt(pipelineChunks, now);
+            for(size_t i = 0; i + 1 < n; i++) {
+                for(auto & c : chunkAt) {
+                    c = topology->reserve(p[i], p[i + 1], chunkBytes, c);
+                }
+                t[i + 1] = *std::max_element(chunkAt.begin(), chunkAt.end());
+            }
+            break;
+        }
+        case CollectiveAlgorithm::Hierarchical: {
+            // Going down the hierarchy, the holder of each group sends the limb to one leader of every subgroup.
+            // The root leads every group it is in, otherwise the lowest numbered participant leads
+            std::map<int,size_t> index;
+            for(size_t i = 0; i < n; i++) {
+                index[p[i]] = i;
+            }
+            std::vector<std::size_t> sizes(topology->groupSizes().rbegin(), topology->groupSizes().rend());
+            sizes.push_back(1);
+            std::size_t parentSize = numChiplets;
+            std::map<std::size_t,int> holders{{0, root}}; // Parent group -> participant that holds the limb
+            for(auto size : sizes) {
+                std::map<std::size_t,int> leaders;
+                for(auto chiplet : p) {
+                    std::size_t group = chiplet / size;
+                    auto it = leaders.find(group);
+                    if(it == leaders.end() || chiplet == root) {
+                        leaders[group] = chiplet;
+                    }
+                }
+                for(auto & [group, leader] : leaders) {
+                    int holder = holders.at(leader / parentSize);
+                    if(holder != leader) {
+                        t[index[leader]] = topology->reserve(holder, leader, limbBytes, t[index[holder]]);
+                    }
+                }
+                holders = leaders;
+                parentSize = size;
+            }
+            break;
+        }
+        case CollectiveAlgorithm::Ring: {
+            // Scatter one chunk to every participant, then all-gather around the ring
+            std::size_t chunkBytes = (limbBytes + n - 1) / n;
+            std::vector<SimTime_t> have(n, now);
+            for(size_t i = 1; i < n; i++) {
+                have[i] = topology->reserve(root, p[i], chunkBytes, now);
+            }
+            t = have;
+            for(size_t round = 0; round + 1 < n; round++) {
+                std::vector<SimTime_t> next(n);
+                for(size_t i = 0; i < n; i++) {
+                    size_t succ = (i + 1) % n;
+                    next[succ] = topology->reserve(p[i], p[succ], chunkBytes, have[i]);
+                }
+                have = next;
+                for(size_t i = 0; i < n; i++) {
+                    t[i] = std::max(t[i], have[i]);
+                }
+            }
+            break;
+        }
+    }
+    return std::vector<SimTime_t>(t.begin() + 1, t.end());
+}
+
+SimTime_t CinnamonNetwork::scheduleAggregation(int root, const std::vector<std::pair<int,SimTime_t>> & contributions){
+    // Participant 0 is the root. t[i] is the time participant i holds its partial sum
+    std::vector<int> p{root};
+    std::vector<SimTime_t> t{0};
+    for(auto & [chiplet, time] : contributions) {
+        if(chiplet == root) {
+            t[0] = time;
+        } else {
+            p.push_back(chiplet);
+            t.push_back(time);
+        }
+    }
+    size_t n = p.size();
+
+    switch(aggregationAlgorithm) {
+        case CollectiveAlgorithm::Direct:
+            for(size_t i = 1; i < n; i++) {
+                t[0] = topology->combine(root, t[0], topology->reserve(p[i], root, limbBytes, t[i]), limbBytes);
+            }
+            break;
+        case CollectiveAlgorithm::BinomialTree:
+            for(size_t step = 1; step < n; step <<= 1) {
+                for(size_t i = 0; i + step < n; i += 2 * step) {
+                    t[i] = topology->combine(p[i], t[i], topology->reserve(p[i + step], p[i], limbBytes, t[i + step]), limbBytes);
+                }
+            }
+            break;
+        case CollectiveAlgorithm::Chain: {
+            // Partial sums flow from the far end of the chain towards the root, chunk by chunk
+            std::size_t chunkBytes = (limbBytes + pipelineChunks - 1) / pipelineChunks;
+            std::vector<SimTime_t> chunkAt(pipelineChunks, t[n - 1]);
+            for(size_t i = n - 1; i > 0; i--) {
+                for(auto & c : chunkAt) {
+                    c = topology->combine(p[i - 1], t[i - 1], topology->reserve(p[i], p[i - 1], chunkBytes, c), chunkBytes);
+                }
+            }
+            t[0] = *std::max_element(chunkAt.begin(), chunkAt.end());
+            break;
+        }
+        case CollectiveAlgorithm::Hierarchical: {
+            // Reduce within the innermost groups first. Each group leader then joins the next tier's reduction
+            std::map<int,SimTime_t> holders;
+            for(size_t i = 0; i < n; i++) {
+                holders[p[i]] = t[i];
+            }
+            holders[root] = t[0];
+            for(auto size : topology->groupSizes()) {
+                std::map<std::size_t,int> leaders;
+                for(auto & [chiplet, time] : holders) {
+                    std::size_t group = chiplet / size;
+                    if(leaders.find(group) == leaders.end() || chiplet == root) {
+                        leaders[group] = chiplet;
+                    }
+                }
+                std::map<int,SimTime_t> next;
+                for(auto & [group, leader] : leaders) {
+                    next[leader] = holders[leader];
+                }
+                for(auto & [chiplet, time] : holders) {
+                    int leader = leaders[chiplet / size];
+                    if(chiplet != leader) {
+                        next[leader] = topology->combine(leader, next[leader], topology->reserve(chiplet, leader, limbBytes, time), limbBytes);
+                    }
+                }
+                holders = next;
+            }
+            for(auto & [chiplet, time] : holders) {
+                if(chiplet != root) {
+                    t[0] = topology->combine(root, t[0], topology->reserve(chiplet, root, limbBytes, time), limbBytes);
+                }
+            }
+            break;
+        }
+        case CollectiveAlgorithm::Ring: {
+            // Reduce-scatter around the ring, then every participant sends its reduced chunk to the root
+            std::size_t chunkBytes = (limbBytes + n - 1) / n;
+            std::vector<SimTime_t> have = t;
+            for(size_t round = 0; round + 1 < n; round++) {
+                std::vector<SimTime_t> next(n);
+                for(size_t i = 0; i < n; i++) {
+                    size_t succ = (i + 1) % n;
+                    next[succ] = topology->combine(p[succ], t[succ], topology->reserve(p[i], p[succ], chunkBytes, have[i]), chunkBytes);
+                }
+                have = next;
+            }
+            t[0] = have[0];
+            for(size_t i = 1; i < n; i++) {
+                t[0] = std::max(t[0], topology->reserve(p[i], root, chunkBytes, have[i]));
+            }
+            break;
+        }
+    }
+    return t[0];
+}
+
+std::string CinnamonNetwork::getOpTypeString(OpType op){
+    switch(op) {
+        case OpType::Brc:
+            return "Brc";
+        case OpType::Agg:
+            return "Agg";
+        case OpType::A2a:
+            return "A2a";
+    }
+    return "Unknown";
+}
+
+CinnamonNetwork::CollectiveAlgorithm CinnamonNetwork::parseCollectiveAlgorithm(const std::string & name){
+    if(name == "direct") {
+        return CollectiveAlgorithm::Direct;
+    } else if(name == "binomialTree") {
+        return CollectiveAlgorithm::BinomialTree;
+    } else if(name == "ring") {
+        return CollectiveAlgorithm::Ring;
+    } else if(name == "chain") {
+        return CollectiveAlgorithm::Chain;
+    } else if(name == "hierarchical") {
+        return CollectiveAlgorithm::Hierarchical;
+    }
+    output->fatal(CALL_INFO, -1, "Unknown collective algorithm: %s\n", name.c_str());
+    return CollectiveAlgorithm::Direct;
+}
+
+std::string CinnamonNetwork::getCollectiveAlgorithmString(CollectiveAlgorithm algorithm){
+    switch(algorithm) {
+        case CollectiveAlgorithm::Direct:
+            return "Direct";
+        case CollectiveAlgorithm::BinomialTree:
+            return "BinomialTree";
+        case CollectiveAlgorithm::Ring:
+            return "Ring";
+        case CollectiveAlgorithm::Chain:
+            return "Chain";
+        case CollectiveAlgorithm::Hierarchical:
+            return "Hierarchical";
+    }
+    return "Unknown";
+}
+
+void CinnamonNetwork::handleDelivery(SST::Event * ev, int portID){
+    std::unique_ptr<CinnamonNetworkEvent> networkEvent(static_cast<CinnamonNetworkEvent *>(ev));
+    progress_++;
+    auto syncID = networkEvent->syncID();
+    auto found = findSync(syncID);
+    if(found == nullptr){
+        output->fatal(CALL_INFO, -1, "%s: %lu Received Spurious Delivery With mismatching syncID: %lu\n",getName().c_str(),cpu->getCurrentSimTime(), syncID);
+        return;
+    }
+
+    auto & syncOp = *found;
+    CINNAMON_VERBOSE(output, 4, 0, "%s: %lu Delivering syncID : %lu to chiplet: %d\n", getName().c_str(), cpu->getCurrentSimCycle(), syncID, portID);
+    // Hop latencies are already part of the delivery time
+    chipletLinks[portID]->send(0, networkEvent.release());
+    bytesReceived[portID]->addData(limbShare(syncOp));
+    portStats_[portID].bytesReceived += limbShare(syncOp);
+    syncOp.decrementOutputsPending();
+    if(syncOp.inputsPending() == 0 && syncOp.outputsPending() == 0){
+        completeOperation(syncID);
+    }
+}
+
 void CinnamonNetwork::completeOperation(uint64_t syncID) {
     std::unique_lock lock(mtx);
-    auto & syncOp = syncOps.at(syncID);
+    auto & syncOp = *findSync(syncID);
     assert(syncOp.inputsPending() == 0);
     assert(syncOp.outputsPending() == 0);
-    output->verbose(CALL_INFO, 3, 0, "Completed Operation for syncID = %ld\n", syncID);
-    syncOps.erase(syncID);
-}
+    CINNAMON_VERBOSE(output, 3, 0, "Completed Operation for syncID = %ld\n", syncID);
 
-bool CinnamonNetwork::tick(SST::Cycle_t cycle) {
-    for(auto & [k,v]: syncOps){
-        if(v.ready()){
-            stats_.busyCycles++;
-            stats_.busyCyclesWindow++;
-            break;
+    // Inputs stay in the ingress buffers until the network has delivered the result
+    if(ingressBufferEntries) {
+        for(auto & [chiplet, time] : syncOp.contributions) {
+            credits[chiplet]++;
+            assert(credits[chiplet] <= ingressBufferEntries);
         }
     }
 
-    if(cycle % 100000 == 0){
-        output->verbose(CALL_INFO, 1, 0, "%s:Heartbeat @ %" PRIu64 " 00K cycles. Network Util Cycles: %" PRIu64 "\n",getName().c_str(),cycle/(100000),stats_.busyCyclesWindow);
-        output->flush();
-        stats_.busyCyclesWindow = 0;
+    SimTime_t now = getCurrentSimTime(timeBase);
+    auto & latency = syncLatency[{syncOp.operation(), syncOp.syncSize()}];
+    SimTime_t barrierWait = syncOp.readyAt - syncOp.registeredAt;
+    SimTime_t inputWait = syncOp.inputsDoneAt - syncOp.readyAt;
+    SimTime_t transfer = now - syncOp.inputsDoneAt;
+    latency.count++;
+    latency.barrierWait += barrierWait;
+    latency.inputWait += inputWait;
+    latency.transfer += transfer;
+    latency.maxTotal = std::max(latency.maxTotal, now - syncOp.registeredAt);
+    auto & statistics = syncStatistics.at({syncOp.operation(), syncOp.syncSize()});
+    statistics.latency->addData(now - syncOp.registeredAt);
+    statistics.barrierWait->addData(barrierWait);
+    statistics.inputWait->addData(inputWait);
+    statistics.transfer->addData(transfer);
+    if(syncTrace.is_open()) {
+        syncTrace << syncID << "," << getOpTypeString(syncOp.operation()) << "," << syncOp.syncSize() << ","
+                  << syncOp.registeredAt << "," << syncOp.readyAt << "," << syncOp.inputsDoneAt << "," << now << "\n";
+    }
+    CINNAMON_VERBOSE(output, 2, 0, "syncID %" PRIu64 " %s syncSize %zu: Barrier Wait %" PRIu64 " ps, Input Wait %" PRIu64 " ps, Transfer %" PRIu64 " ps\n",
+                syncID, getOpTypeString(syncOp.operation()).c_str(), syncOp.syncSize(), barrierWait, inputWait, transfer);
+    assert(syncOp.ready() && readySyncs > 0);
+    readySyncs--;
+    eraseSync(syncID);
+}
+
+bool CinnamonNetwork::tick(SST::Cycle_t cycle) {
+    if(readySyncs > 0){
+        stats_.busyCycles++;
+        busyCyclesStatistic->addData(1);
+    }
+    if(linkSampleInterval && cycle % linkSampleInterval == 0){
+        sampleLinks();
     }
     stats_.totalCycles++;
     bufferTick(cycle);
     return true;
 }
 
+uint64_t CinnamonNetwork::bytesMoved() const {
+    uint64_t bytes = 0;
+    for(auto & portStats: portStats_) {
+        bytes += portStats.bytesSent + portStats.bytesReceived;
+    }
+    return bytes;
+}
+
+std::string CinnamonNetwork::dumpState() const {
+    std::stringstream s;
+    auto describe = [&s](const SyncOperation & syncOp) {
+        s << "\tsyncID " << syncOp.syncID_ << " " << getOpTypeString(syncOp.operation()) << ": "
+          << syncOp.readyCount() << " of " << syncOp.syncSize() << " chiplets registered, "
+          << syncOp.inputsPending() << " inputs and " << syncOp.outputsPending() << " outputs pending";
+        if(!syncOp.contributions.empty()) {
+            s << ", inputs from";
+            for(auto & [chiplet, time]: syncOp.contributions) {
+                s << " " << chiplet;
+            }
+        }
+        s << "\n";
+    };
+    s << "Network: " << activeSyncs << " active syncs, " << readySyncs << " ready\n";
+    for(auto & syncOp: syncTable) {
+        if(syncOp.valid()) {
+            describe(syncOp);
+        }
+    }
+    for(auto & [syncID, syncOp]: syncOverflow) {
+        describe(syncOp);
+    }
+    for(size_t port = 0; port < outputBWBuffer.size(); port++) {
+        if(!outputBWBuffer[port].empty() || !pendingOutput[port].empty()) {
+            s << "\tPort " << port << ": " << outputBWBuffer[port].size() << " outputs buffered, "
+              << pendingOutput[port].size() << " waiting for buffer space\n";
+        }
+    }
+    if(ingressBufferEntries) {
+        s << "\tIngress credits:";
+        for(auto credit: credits) {
+            s << " " << credit;
+        }
+        s << "\n";
+    }
+    return s.str();
+}
+
+void CinnamonNetwork::sampleLinks() {
+    for(size_t linkID = 0; linkID < linkBusy.size(); linkID++){
+        auto busyTime = topology->linkBusyTime(linkID);
+        linkBusy[linkID]->addData(busyTime - linkBusySampled[linkID]);
+        linkBusySampled[linkID] = busyTime;
+    }
+}
+
+CinnamonNetwork::SyncOperation * CinnamonNetwork::findSync(uint64_t syncID) {
+    auto & slot = syncTable[syncID % syncTable.size()];
+    if(slot.syncID_ == syncID) {
+        return &slot;
+    }
+    if(syncOverflow.empty()) {
+        return nullptr;
+    }
+    auto it = syncOverflow.find(syncID);
+    return it == syncOverflow.end() ? nullptr : &it->second;
+}
+
+const CinnamonNetwork::SyncOperation * CinnamonNetwork::findSync(uint64_t syncID) const {
+    return const_cast<CinnamonNetwork *>(this)->findSync(syncID);
+}
+
+CinnamonNetwork::SyncOperation & CinnamonNetwork::insertSync(SyncOperation && syncOp) {
+    activeSyncs++;
+    auto syncID = syncOp.syncID_;
+    auto & slot = syncTable[syncID % syncTable.size()];
+    if(!slot.valid()) {
+        slot = std::move(syncOp);
+        return slot;
+    }
+    // Another live sync holds the slot. Correct but slow, so count it and let the user grow syncWindow
+    stats_.syncOverflows++;
+    return syncOverflow[syncID] = std::move(syncOp);
+}
+
+void CinnamonNetwork::eraseSync(uint64_t syncID) {
+    activeSyncs--;
+    auto & slot = syncTable[syncID % syncTable.size()];
+    if(slot.syncID_ == syncID) {
+        slot = SyncOperation();
+    } else {
+        syncOverflow.erase(syncID);
+    }
+}
+
+std::size_t CinnamonNetwork::limbShare(const SyncOperation & syncOp) const {
+    if(syncOp.operation() == OpType::A2a) {
+        auto n = syncOp.broadcastDestinations().size();
+        return limbBytes * (n - 1) / n;
+    }
+    return limbBytes;
+}
+
+bool CinnamonNetwork::tryAcquireCredit(size_t chipletID, SST::Cycle_t cycle) {
+    if(ingressBufferEntries == 0) {
+        return true;
+    }
+    if(credits[chipletID] == 0) {
+        auto & portStats = portStats_[chipletID];
+        if(portStats.lastStallCycle != cycle) {
+            portStats.backPressureStallCycles++;
+            portStats.lastStallCycle = cycle;
+        }
+        return false;
+    }
+    credits[chipletID]--;
+    return true;
+}
+
+void CinnamonNetwork::enqueueOutput(int portID, const CinnamonNetworkOutputBWEntry & entry) {
+    if(egressBufferEntries && (outputBWBuffer[portID].size() >= egressBufferEntries || !pendingOutput[portID].empty())) {
+        // Egress buffer is full, the entry waits in the ingress buffer
+        pendingOutput[portID].push_back(entry);
+        return;
+    }
+    outputBWBuffer[portID].push_back(entry);
+}
+
 bool CinnamonNetwork::bufferTick(SST::Cycle_t cycle) {
+    for(size_t i = 0; i < numChiplets; i++){
+        if(!pendingOutput[i].empty()){
+            portStats_[i].egressFullCycles++;
+            while(!pendingOutput[i].empty() && outputBWBuffer[i].size() < egressBufferEntries){
+                outputBWBuffer[i].push_back(pendingOutput[i].front());
+                pendingOutput[i].pop_front();
+            }
+        }
+    }
     for(size_t i = 0; i < numChiplets; i++){
         if(outputBWBuffer[i].empty()){
             continue;
@@ -228,8 +813,10 @@ bool CinnamonNetwork::bufferTick(SST::Cycle_t cycle) {
         if(bufferEntry.inFlight) {
             continue;
         }
+        // Entries smaller than a limb (e.g. an all-to-all share) hold the port for proportionally less time
+        SimTime_t sendTime = std::max<SimTime_t>(1, limbOutputTime * bufferEntry.size / limbBytes);
         auto packet = std::make_unique<CinnamonNetworkEvent>(bufferEntry.syncID);
-        outputTiming[i]->send(1,packet.release());
+        outputTiming[i]->send(sendTime,packet.release());
         bufferEntry.inFlight = true;
     }
     return true;
@@ -246,7 +833,7 @@ bool CinnamonNetwork::tryRegisterSync(size_t ChipletID, uint64_t id, uint64_t sy
         operation = op;
         inputsPending = 0;
         outputsPending = 0;
-        output->verbose(CALL_INFO, 4, 0, "Registered Sync for syncID = %ld\n", syncID.value());
+        CINNAMON_VERBOSE(output, 4, 0, "Registered Sync for syncID = %ld\n", syncID.value());
         if(recvValue) {
             inputsPending++;
         }
@@ -273,7 +860,7 @@ bool CinnamonNetwork::tryRegisterSync(size_t ChipletID, uint64_t id, uint64_t sy
                 aggregateDestination = ChipletID;
             }
         }
-        output->verbose(CALL_INFO, 4, 0, "Increment readyCount to %ld for syncID = %ld\n", readyCount,syncID.value());
+        CINNAMON_VERBOSE(output, 4, 0, "Increment readyCount to %ld for syncID = %ld\n", readyCount,syncID.value());
         return true;
     }
     return false;
@@ -315,7 +902,7 @@ void CinnamonNetwork::handleInput(SST::Event * ev, int portID){
     }
     inputsPending--;
     assert(inputsPending >= 0);
-    output->verbose(CALL_INFO, 4, 2, "%s: %lu Received Incoming with syncID : %lu\n", getName().c_str(), cpu->getCurrentSimCycle(), networkEvent->syncID());
+    CINNAMON_VERBOSE(output, 4, 2, "%s: %lu Received Incoming with syncID : %lu\n", getName().c_str(), cpu->getCurrentSimCycle(), networkEvent->syncID());
     if(inputsPending == 0) {
         if(operation == OpType::Brc){
             for(size_t i = 0; i < numChiplets; i++){
@@ -349,7 +936,7 @@ void CinnamonNetwork::handleOutput(SST::Event * ev, int portID){
     if(networkEvent->syncID() != syncID.value()){
         output->fatal(CALL_INFO, -1, "%s: %lu Received Spurious Incoming With mismatching syncID. Expected: %lu, Got: %lu\n",getName().c_str(),cpu->getCurrentSimTime(), networkEvent->syncID(),syncID.value());
     }
-    output->verbose(CALL_INFO, 1, 4, "%s: %lu Outputing syncID : %lu to chiplet: %d\n", getName().c_str(), cpu->getCurrentSimCycle(), networkEvent->syncID(),portID);
+    CINNAMON_VERBOSE(output, 1, 4, "%s: %lu Outputing syncID : %lu to chiplet: %d\n", getName().c_str(), cpu->getCurrentSimCycle(), networkEvent->syncID(),portID);
     auto responseEvent = std::make_unique<CinnamonNetworkEvent>(networkEvent->syncID());
     // chipletLinks[portID]->send(hops /*Latency */, responseEvent.release());
 
@@ -368,7 +955,7 @@ void CinnamonNetwork::completeOperation() {
     std::unique_lock lock(mtx);
     assert(inputsPending == 0);
     assert(outputsPending == 0);
-    output->verbose(CALL_INFO, 3, 0, "Completed Operation for syncID = %ld\n", syncID.value());
+    CINNAMON_VERBOSE(output, 3, 0, "Completed Operation for syncID = %ld\n", syncID.value());
     syncID.reset();
     readyCount == 0;
     inputsPending = 0;
@@ -395,6 +982,24 @@ std::string CinnamonNetwork::printStats() const {
     s << "\tBusy Cycles: " << stats_.busyCycles << "\n";
     double utilisation = ((100.0) * stats_.busyCycles)/stats_.totalCycles;
     s << "\tUtilisation %: " << utilisation << "\n";
+    s << "\tSync Table Overflows: " << stats_.syncOverflows << "\n";
+    s << topology->printStats(getCurrentSimTime(timeBase));
+    if(ingressBufferEntries || egressBufferEntries) {
+        for(size_t i = 0; i < numChiplets; i++){
+            s << "\tChiplet " << i << " Back-pressure Stall Cycles: " << portStats_[i].backPressureStallCycles;
+            s << " Egress Full Cycles: " << portStats_[i].egressFullCycles << "\n";
+        }
+    }
+    s << "\tBroadcast Algorithm: " << getCollectiveAlgorithmString(broadcastAlgorithm) << "\n";
+    s << "\tAggregation Algorithm: " << getCollectiveAlgorithmString(aggregationAlgorithm) << "\n";
+    for(auto & [key, latency] : syncLatency) {
+        s << "\t" << getOpTypeString(key.first) << " syncSize " << key.second << ":";
+        s << " Count: " << latency.count;
+        s << " Avg Barrier Wait (ps): " << latency.barrierWait / latency.count;
+        s << " Avg Input Wait (ps): " << latency.inputWait / latency.count;
+        s << " Avg Transfer (ps): " << latency.transfer / latency.count;
+        s << " Max Total (ps): " << latency.maxTotal << "\n";
+    }
     return s.str();
 }
 
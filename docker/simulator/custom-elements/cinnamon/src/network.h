@@ -5,8 +5,10 @@
 #include <optional>
 #include <shared_mutex>
 #include <cmath>
+#include <fstream>
 #include <sst/core/params.h>
 #include <sst/core/subcomponent.h>
+#include "topology.h"
 
 namespace SST {
 namespace Cinnamon {
@@ -33,7 +35,17 @@ class CinnamonNetwork : public SubComponent {
 public:
     enum OpType {
         Brc, // Broadcast
-        Agg  // Aggregate
+        Agg, // Aggregate
+        A2a  // All-to-all. Every participant sends a 1/n chunk of its limb to every other participant
+    };
+
+    // How a broadcast or aggregation is spread over an explicit topology
+    enum class CollectiveAlgorithm {
+        Direct,       // Every destination (contributor) talks to the root directly
+        BinomialTree, // log2(n) rounds, the number of nodes holding the limb doubles every round
+        Ring,         // The limb is split into n chunks. Scatter + all-gather, or reduce-scatter + gather
+        Chain,        // The limb is split into pipelineChunks chunks that are forwarded along a chain
+        Hierarchical  // One leader per package (then board) relays, so slow outer links carry one limb per group
     };
 
     CinnamonNetwork(ComponentId_t id, Params &params, CinnamonCPU * cpu, size_t numChiplets);
@@ -58,6 +70,49 @@ public:
     // SST_ELI_DOCUMENT_PORTS(
     //     {"memory_link", "Link to the memory hierarchy (e.g., HBM)", {"memHierarchy.memEvent", ""}})
 
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"linkBW", "Bandwidth of a chiplet link", ""},
+        {"topology", "Interconnect topology: ideal (log2 hop model), ring, mesh, torus, fullyConnected, fatTree or hierarchical", "ideal"},
+        {"chipletsPerPackage", "Chiplets sharing a package switch in the hierarchical topology", "16"},
+        {"packagesPerBoard", "Packages sharing a board switch. 0 connects packages directly to the system switch", "0"},
+        {"packageLinkBW", "Bandwidth of a package uplink", "64GB/s"},
+        {"packageHopLatency", "Latency of a package uplink", "50ns"},
+        {"boardLinkBW", "Bandwidth of a board uplink", "25GB/s"},
+        {"boardHopLatency", "Latency of a board uplink", "500ns"},
+        {"hopLatency", "Latency of one link traversal. Not used by the ideal topology", "5ns"},
+        {"meshColumns", "Number of columns of a mesh or torus. Must divide the number of chiplets", "ceil(sqrt(num_chiplets))"},
+        {"packetSize", "Bytes per packet. 0 sends each limb as a single packet. Not used by the ideal topology", "0"},
+        {"flitSize", "Bytes per flit. When non-zero, packets cut through each hop after their first flit", "0"},
+        {"streamingReceive", "Let Rcv/Joi consumers start on the first packets instead of waiting for the whole limb", "false"},
+        {"broadcastAlgorithm", "Collective used for Brc on an explicit topology: direct, binomialTree, ring, chain or hierarchical", "direct"},
+        {"aggregationAlgorithm", "Collective used for Agg on an explicit topology: direct, binomialTree, ring, chain or hierarchical", "direct"},
+        {"reduction", "Where Agg partial sums are added: none (free), endpoint (receiving chiplet) or inNetwork (routers/switches)", "none"},
+        {"switchAdderBW", "Throughput of the adder in each router/switch for in-network reduction", "512GB/s"},
+        {"switchAdderLatency", "Latency of one in-network addition", "2ns"},
+        {"endpointAdderBW", "Throughput a chiplet's add units give to endpoint reduction", "256GB/s"},
+        {"endpointAdderLatency", "Latency of one endpoint addition", "5ns"},
+        {"ingressBufferEntries", "Limbs each chiplet can have buffered at network ingress. Senders stall without a credit. 0 is unbounded", "0"},
+        {"egressBufferEntries", "Limbs each output port can buffer on the ideal topology. Further outputs wait at ingress. 0 is unbounded", "0"},
+        {"pipelineChunks", "Number of chunks a limb is split into by the chain collective", "8"},
+        {"switchRadix", "Number of chiplets attached to each leaf switch of a fatTree", "8"},
+        {"fatTreeTaper", "Oversubscription of fatTree uplinks. 1 gives full bisection bandwidth", "1"},
+        {"syncWindow", "Slots in the sync table. Syncs whose IDs collide modulo the window fall back to a slower map", "4096"},
+        {"linkSampleInterval", "Cycles between link_busy samples. 0 disables link sampling", "10000"},
+        {"syncTraceFile", "CSV file that receives one row of timestamps per completed syncID. Empty disables the trace", ""})
+
+    // Sync statistics have a subId of <OpType>_<syncSize> (e.g. Brc_8), port statistics the chiplet ID and
+    // link statistics <from>_<to>. Use a histogram statistic type in the configuration to get latency distributions
+    SST_ELI_DOCUMENT_STATISTICS(
+        {"sync_latency", "Time from the first chiplet registering a sync to the network delivering it", "ps", 1},
+        {"sync_barrier_wait", "Time from the first to the last chiplet registering a sync", "ps", 2},
+        {"sync_input_wait", "Time from the last registration to the last input reaching the network", "ps", 2},
+        {"sync_transfer", "Time from the last input reaching the network to delivery", "ps", 2},
+        {"busy_cycles", "Cycles with at least one sync ready to transfer", "cycles", 1},
+        {"bytes_sent", "Bytes a chiplet sent into the network", "bytes", 1},
+        {"bytes_received", "Bytes the network delivered to a chiplet", "bytes", 1},
+        {"link_busy", "Busy time booked on a topology link per linkSampleInterval. Explicit topologies only", "ps", 3})
+
     SST_ELI_DOCUMENT_PORTS( 
      { "chiplet_port_%(numChiplets)d",  "Ports which connect to chiplets.", { } }
     )
@@ -71,8 +126,21 @@ public:
     // Return true if all chiplets have reached the synchronisation barrier for a syncID
     bool networkReady(uint64_t id) const;
 
+    // Take an ingress buffer entry before sending a value to the network. Returns false when the
+    // chiplet has no credits left; the credit comes back once the network has delivered the sync
+    bool tryAcquireCredit(size_t chipletID, SST::Cycle_t cycle);
+
     std::string printStats() const;
 
+    // Counts sync registrations and events handled, so the CPU watchdog can tell the network is moving
+    uint64_t progress() const {
+        return progress_;
+    }
+    // Bytes chiplets sent into the network plus bytes it delivered, for the energy model
+    uint64_t bytesMoved() const;
+    // Pending syncOps, buffered outputs and credits for the watchdog state dump
+    std::string dumpState() const;
+
 private:
     CinnamonNetwork();                       // Serialization only
     CinnamonNetwork(const CinnamonNetwork &);   // Do not impl.
@@ -93,6 +161,18 @@ private:
         std::vector<int> broadcastDestinations_;
         int minDestination = 100000;
         int maxDestination = -1;
+        SimTime_t lastArrival = 0; // Latest contribution arrival at the aggregation destination (ps)
+        std::vector<std::pair<int,SimTime_t>> contributions; // Chiplet and time each input reached the network
+        std::map<int,SimTime_t> arrivals; // All-to-all: time the last chunk for each participant arrives
+
+        // Latency breakdown (ps)
+        SimTime_t registeredAt = 0; // First chiplet registered the sync
+        SimTime_t readyAt = 0;      // Last chiplet registered the sync
+        SimTime_t inputsDoneAt = 0; // Last input reached the network
+
+        bool valid() const {
+            return syncID_ != static_cast<uint64_t>(-1);
+        }
 
         SyncOperation() : syncID_(-1), syncSize_(-1), readyCount_(-1), inputsPending_(-1), outputsPending_(-1), aggregationDestination_(-1) {}
         SyncOperation(uint64_t syncID, size_t syncSize, OpType operation) : syncID_(syncID), syncSize_(syncSize), readyCount_(0), operation_(operation), inputsPending_(0), outputsPending_(0), aggregationDestination_(-1), minDestination(10000), maxDestination(-1) {}
@@ -106,11 +186,12 @@ private:
         }
         void incrementReadyCount(size_t chipID){
             readyCount_++;
-            if(chipID > maxDestination) {
-                maxDestination = chipID;
+            int chip = static_cast<int>(chipID);
+            if(chip > maxDestination) {
+                maxDestination = chip;
             }
-            if(chipID < minDestination) {
-                minDestination = chipID;
+            if(chip < minDestination) {
+                minDestination = chip;
             }
         }
         void incrementInputsPending(){
@@ -174,8 +255,20 @@ private:
     };
 
 
-    std::map<uint64_t,SyncOperation> syncOps;
+    // In-flight syncs live in a dense ring indexed by syncID modulo its size. IDs that collide with a
+    // live sync go to syncOverflow, which stays empty while the window covers all in-flight syncs
+    std::vector<SyncOperation> syncTable;
+    std::map<uint64_t,SyncOperation> syncOverflow;
+    size_t activeSyncs = 0;
+    size_t readySyncs = 0; // Syncs all participants have registered, drives the busy cycle count
+    uint64_t progress_ = 0;
     std::vector<std::deque<CinnamonNetworkOutputBWEntry>> outputBWBuffer;
+    std::vector<std::deque<CinnamonNetworkOutputBWEntry>> pendingOutput; // Waiting for space in outputBWBuffer
+
+    // Credit based flow control
+    size_t ingressBufferEntries = 0;
+    size_t egressBufferEntries = 0;
+    std::vector<size_t> credits;
 
     // std::vector<std::unordered_map<uint64_t,CinnamonNetworkOutputBWEntry*>> outstandingRequests;
 
@@ -183,7 +276,18 @@ private:
     // size_t readyCount;
     // OpType operation;
     int hops;
-    mutable std::shared_mutex mtx;
+#ifdef CINNAMON_THREADED_NETWORK
+    using NetworkMutex = std::shared_mutex;
+#else
+    // The CPU ticks every chiplet and the network from one clock handler, so nothing to exclude
+    struct NetworkMutex {
+        void lock() {}
+        void unlock() {}
+        void lock_shared() {}
+        void unlock_shared() {}
+    };
+#endif
+    mutable NetworkMutex mtx;
 
     // int outputsPending;
     // int inputsPending;
@@ -193,17 +297,76 @@ private:
     std::vector<Link *> chipletLinks;
     std::vector<Link *> outputTiming;
 
+    std::unique_ptr<CinnamonTopology> topology;
+    CollectiveAlgorithm broadcastAlgorithm = CollectiveAlgorithm::Direct;
+    CollectiveAlgorithm aggregationAlgorithm = CollectiveAlgorithm::Direct;
+    std::size_t pipelineChunks = 8;
+    TimeConverter * timeBase; // Topology times are in picoseconds
+    std::vector<Link *> deliveryLinks;
+    std::size_t limbBytes = 224*1024;
+    SimTime_t limbOutputTime = 1; // Picoseconds to send one limb on an output port
+
     struct Stats {
         SST::Cycle_t totalCycles = 0;
         SST::Cycle_t busyCycles = 0;
-        SST::Cycle_t busyCyclesWindow = 0;
+        uint64_t syncOverflows = 0;
     } stats_;
 
+    struct SyncLatency {
+        uint64_t count = 0;
+        SimTime_t barrierWait = 0; // registeredAt -> readyAt
+        SimTime_t inputWait = 0;   // readyAt -> inputsDoneAt
+        SimTime_t transfer = 0;    // inputsDoneAt -> completion
+        SimTime_t maxTotal = 0;
+    };
+    std::map<std::pair<OpType,size_t>,SyncLatency> syncLatency; // Keyed by operation and syncSize
+
+    struct PortStats {
+        SST::Cycle_t backPressureStallCycles = 0;
+        SST::Cycle_t egressFullCycles = 0;
+        SST::Cycle_t lastStallCycle = -1;
+        uint64_t bytesSent = 0;
+        uint64_t bytesReceived = 0;
+    };
+    std::vector<PortStats> portStats_;
+
+    struct SyncStatistics {
+        Statistic<uint64_t> * latency;
+        Statistic<uint64_t> * barrierWait;
+        Statistic<uint64_t> * inputWait;
+        Statistic<uint64_t> * transfer;
+    };
+    std::map<std::pair<OpType,size_t>,SyncStatistics> syncStatistics; // Keyed by operation and syncSize
+    Statistic<uint64_t> * busyCyclesStatistic;
+    std::vector<Statistic<uint64_t> *> bytesSent;     // Indexed by chiplet
+    std::vector<Statistic<uint64_t> *> bytesReceived; // Indexed by chiplet
+    std::vector<Statistic<uint64_t> *> linkBusy;      // Indexed by topology link
+    std::vector<SimTime_t> linkBusySampled;           // Link busy time at the last sample
+    SST::Cycle_t linkSampleInterval = 10000;
+    std::ofstream syncTrace;
+
 
     // Mark the operation as complete and make the network ready to accept the next operation
     void completeOperation(uint64_t syncID);
     void handleInput(SST::Event * ev, int id);
     void handleOutput(SST::Event * ev, int id);
+    // Route the contribution that just arrived from a chiplet over the topology
+    void routeInput(SyncOperation & syncOp, uint64_t syncID, int portID);
+    void handleDelivery(SST::Event * ev, int id);
+    void enqueueOutput(int portID, const CinnamonNetworkOutputBWEntry & entry);
+    SyncOperation * findSync(uint64_t syncID);
+    const SyncOperation * findSync(uint64_t syncID) const;
+    SyncOperation & insertSync(SyncOperation && syncOp);
+    void eraseSync(uint64_t syncID);
+    // Bytes of a limb that one participant sends / receives for the operation
+    std::size_t limbShare(const SyncOperation & syncOp) const;
+    void sampleLinks();
+    // Return the time each destination holds the limb / the root holds the reduced limb
+    std::vector<SimTime_t> scheduleBroadcast(int root, const std::vector<int> & destinations, SimTime_t now);
+    SimTime_t scheduleAggregation(int root, const std::vector<std::pair<int,SimTime_t>> & contributions);
+    CollectiveAlgorithm parseCollectiveAlgorithm(const std::string & name);
+    static std::string getCollectiveAlgorithmString(CollectiveAlgorithm algorithm);
+    static std::string getOpTypeString(OpType op);
 };
 } // namespace Cinnamon
 } // namespace SST
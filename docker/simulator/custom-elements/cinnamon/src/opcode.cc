@@ -35,6 +35,9 @@ std::string getOpCodeString(CinnamonInstructionOpCode opCode)
     case OpCode::Joi:
         str = "Joi";
         break;
+    case OpCode::A2a:
+        str = "A2a";
+        break;
     case OpCode::Add:
         str = "Add";
         break;
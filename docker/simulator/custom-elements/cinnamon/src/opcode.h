@@ -16,6 +16,7 @@ enum class CinnamonInstructionOpCode {
     Dis,
     Rcv,
     Joi,
+    A2a,
     Add,
     Sub,
     Neg,
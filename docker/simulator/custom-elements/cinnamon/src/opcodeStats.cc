@@ -0,0 +1,95 @@
+#include "sst/core/sst_config.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "opcodeStats.h"
+
+namespace SST {
+namespace Cinnamon {
+
+void CinnamonOpcodeStats::Latency::add(SST::Cycle_t cycles) {
+    total += cycles;
+    max = std::max(max, cycles);
+    // Bucket b holds [2^(b-1), 2^b), bucket 0 holds zero cycle latencies
+    size_t bucket = 0;
+    while(cycles > 0 && bucket < numBuckets - 1) {
+        cycles >>= 1;
+        bucket++;
+    }
+    histogram[bucket]++;
+}
+
+void CinnamonOpcodeStats::Latency::merge(const Latency & other) {
+    total += other.total;
+    max = std::max(max, other.max);
+    for(size_t bucket = 0; bucket < numBuckets; bucket++) {
+        histogram[bucket] += other.histogram[bucket];
+    }
+}
+
+std::string CinnamonOpcodeStats::Latency::printHistogram() const {
+    std::stringstream s;
+    for(size_t bucket = 0; bucket < numBuckets; bucket++) {
+        if(histogram[bucket] == 0) {
+            continue;
+        }
+        s << " ";
+        if(bucket == 0) {
+            s << "0";
+        } else if(bucket == numBuckets - 1) {
+            s << ">=" << (1ull << (bucket - 1));
+        } else {
+            s << "<" << (1ull << bucket);
+        }
+        s << ":" << histogram[bucket];
+    }
+    return s.str();
+}
+
+void CinnamonOpcodeStats::record(OpCode opCode, SST::Cycle_t dispatchToIssue, SST::Cycle_t issueToComplete) {
+    auto & op = opcodes[static_cast<size_t>(opCode)];
+    op.count++;
+    op.dispatchToIssue.add(dispatchToIssue);
+    op.issueToComplete.add(issueToComplete);
+}
+
+void CinnamonOpcodeStats::merge(const CinnamonOpcodeStats & other) {
+    for(size_t i = 0; i < opcodes.size(); i++) {
+        opcodes[i].count += other.opcodes[i].count;
+        opcodes[i].dispatchToIssue.merge(other.opcodes[i].dispatchToIssue);
+        opcodes[i].issueToComplete.merge(other.opcodes[i].issueToComplete);
+    }
+}
+
+std::string CinnamonOpcodeStats::printStats(const std::string & title, bool histograms) const {
+    std::stringstream s;
+    s << title << ":\n";
+    s << "\t" << std::left << std::setw(8) << "Opcode" << std::right
+      << std::setw(12) << "Executed"
+      << std::setw(16) << "Dispatch-Issue"
+      << std::setw(10) << "Max"
+      << std::setw(16) << "Issue-Complete"
+      << std::setw(10) << "Max" << "\n";
+    for(size_t i = 0; i < opcodes.size(); i++) {
+        auto & op = opcodes[i];
+        if(op.count == 0) {
+            continue;
+        }
+        s << "\t" << std::left << std::setw(8) << getOpCodeString(static_cast<OpCode>(i)) << std::right
+          << std::setw(12) << op.count
+          << std::setw(16) << std::fixed << std::setprecision(1) << static_cast<double>(op.dispatchToIssue.total) / op.count
+          << std::setw(10) << op.dispatchToIssue.max
+          << std::setw(16) << static_cast<double>(op.issueToComplete.total) / op.count
+          << std::setw(10) << op.issueToComplete.max << "\n";
+        if(histograms) {
+            s << "\t\tDispatch-Issue:" << op.dispatchToIssue.printHistogram() << "\n";
+            s << "\t\tIssue-Complete:" << op.issueToComplete.printHistogram() << "\n";
+        }
+    }
+    return s.str();
+}
+
+} // Namespace Cinnamon
+} // Namespace SST
@@ -0,0 +1,53 @@
+#ifndef _H_SST_CINNAMON_OPCODE_STATS
+#define _H_SST_CINNAMON_OPCODE_STATS
+
+#include <array>
+#include <string>
+
+#include "sst/core/sst_types.h"
+#include "opcode.h"
+
+namespace SST {
+namespace Cinnamon {
+
+// Executed instruction counts and latencies per opcode.
+//
+// Instructions are counted when they complete, under the opcode of the instruction a unit executed
+// (split parts of Ntt, SuD or Pl1 are counted as Ntt, Int, BcR, BcW, Mul, ...). Dispatch to issue is the
+// time from dispatching the trace instruction to the first unit reservation, issue to complete runs to
+// the end of execution. Histograms have power of two buckets.
+class CinnamonOpcodeStats {
+public:
+    using OpCode = CinnamonInstructionOpCode;
+    static constexpr size_t numBuckets = 24; // The last bucket also holds everything above 2^22 cycles
+
+    void record(OpCode opCode, SST::Cycle_t dispatchToIssue, SST::Cycle_t issueToComplete);
+    // Adds the counts of another chiplet, for the system wide report
+    void merge(const CinnamonOpcodeStats & other);
+    // histograms adds the latency distribution of every opcode to the table of counts and means
+    std::string printStats(const std::string & title, bool histograms) const;
+
+private:
+    struct Latency {
+        uint64_t total = 0;
+        SST::Cycle_t max = 0;
+        std::array<uint64_t, numBuckets> histogram{};
+
+        void add(SST::Cycle_t cycles);
+        void merge(const Latency & other);
+        std::string printHistogram() const;
+    };
+
+    struct Opcode {
+        uint64_t count = 0;
+        Latency dispatchToIssue;
+        Latency issueToComplete;
+    };
+
+    std::array<Opcode, static_cast<size_t>(OpCode::NUM_OPCODES)> opcodes;
+};
+
+} // Namespace Cinnamon
+} // Namespace SST
+
+#endif // _H_SST_CINNAMON_OPCODE_STATS
@@ -19,8 +19,19 @@ void PhysicalRegister::addToFreeListIfFree() {
         return;
     }
     if (type == PhysicalRegister_t::Vector) {
+        pe->statistics_.vectorRegisterLifetime->addData(pe->currentCycle_ - allocatedAt);
+        if (readyAt.has_value() && !read) {
+            // Freed without a read, so the value was ready and unread until now
+            pe->statistics_.vectorReadyUnread->addData(pe->currentCycle_ - readyAt.value());
+            pe->statistics_.vectorRegistersUnread->addData(1);
+        }
         pe->freeVectorRegisters.push(id);
+        if (pe->eventLogActive()) {
+            pe->eventLog_->record(CinnamonEventLog::Kind::RegisterFree, pe->chipletID_, pe->registerTrack, id,
+                                  CinnamonEventLog::NoOpCode, pe->currentCycle_, pe->currentCycle_);
+        }
     } else if (type == PhysicalRegister_t::Scalar) {
+        pe->statistics_.scalarRegisterLifetime->addData(pe->currentCycle_ - allocatedAt);
         pe->freeScalarRegisters.push(id);
     } else if (type == PhysicalRegister_t::Forwarding) {
         ;
@@ -29,5 +40,25 @@ void PhysicalRegister::addToFreeListIfFree() {
     }
 }
 
+void PhysicalRegister::allocate() {
+    allocatedAt = pe->currentCycle_;
+    readyAt.reset();
+    read = false;
+}
+
+void PhysicalRegister::markReady() {
+    readyAt = pe->currentCycle_;
+}
+
+void PhysicalRegister::markRead() {
+    if (read || !readyAt.has_value()) {
+        return;
+    }
+    read = true;
+    if (type == PhysicalRegister_t::Vector) {
+        pe->statistics_.vectorReadyUnread->addData(pe->currentCycle_ - readyAt.value());
+    }
+}
+
 } // namespace Cinnamon
 } // namespace SST
\ No newline at end of file
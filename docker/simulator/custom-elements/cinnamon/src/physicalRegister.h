@@ -6,6 +6,8 @@
 #include <sstream>
 #include <string>
 
+#include "stallStack.h"
+
 
 namespace SST {
 namespace Cinnamon {
@@ -30,15 +32,40 @@ private:
     // bool mapped;
     std::optional<std::uint16_t> mappedVirtualReg;
     std::int16_t references;
+    CinnamonStallStack::Producer producer = CinnamonStallStack::Producer::Compute;
+
+    // Lifetime of the current value, in chiplet cycles
+    std::uint64_t allocatedAt = 0;
+    std::optional<std::uint64_t> readyAt;
+    bool read = false;
 
     void addToFreeListIfFree();
+    void markReady();
 
 public:
     PhysicalRegister(CinnamonChiplet *pe, const PhysicalRegister_t type, const std::uint16_t id) : pe(pe), type(type), id(id), valueReady(false), isFree(true), references(0){};
     PhysicalRegister(const PhysicalRegister_t type, const std::uint16_t id) : pe(nullptr), type(type), id(id), valueReady(false), isFree(true), references(0) { assert(type == PhysicalRegister_t::Forwarding); };
-    void setValueReady(bool b) { valueReady = b; }
+    void setValueReady(bool b) {
+        if (b && pe && !readyAt.has_value()) {
+            markReady();
+        }
+        valueReady = b;
+    }
     bool getValueReady() const { return valueReady; }
+    // Producer of the value while it is not ready
+    std::optional<CinnamonStallStack::Producer> blockingProducer() const {
+        if (valueReady) {
+            return std::nullopt;
+        }
+        return producer;
+    }
+    // Called when the register is taken from the free list
+    void allocate();
+    // Called when an instruction reading the register issues. Only the first read of a value is recorded
+    void markRead();
     PhysicalRegisterID_t getID() const { return id; }
+    // Class of the instruction the register was last mapped as a destination for
+    void setProducer(CinnamonStallStack::Producer p) { producer = p; }
 
     std::int16_t numReferences() const {
         return references;
@@ -71,6 +71,12 @@ public:
 	~CinnamonTraceReader() { };
 	virtual std::unique_ptr<CinnamonParsedInstruction> readNextInstruction(uint64_t instrId) = 0;
 
+	// Size of the trace and how much of it has been read, for progress reporting. 0 if unknown
+	virtual uint64_t traceBytes() const { return 0; }
+	virtual uint64_t traceBytesRead() const { return 0; }
+	// Trace file the reader was configured with. Empty if the reader has none
+	virtual std::string traceName() const { return ""; }
+
 protected:
 
 };
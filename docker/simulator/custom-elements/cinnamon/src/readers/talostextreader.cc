@@ -41,8 +41,14 @@ CinnamonTextTraceReader::CinnamonTextTraceReader( ComponentId_t id, Params& para
                     getName().c_str(), traceFileName.c_str());
 	}
 
+	traceInputFile.seekg(0, std::ios::end);
+	traceSize = traceInputFile.tellg();
+	traceInputFile.seekg(0, std::ios::beg);
+
 	std::string line;
-	if( getline (traceInputFile,line) ) {};
+	if( getline (traceInputFile,line) ) {
+		bytesRead += line.size() + 1;
+	}
 
 }
 
@@ -243,9 +249,35 @@ std::unique_ptr<CinnamonParsedInstruction> CinnamonTextTraceReader::handle_joi(c
 
 }
 
+// a2a @ syncID:syncSize dest: src
+// Every participant sends its src to the others and receives its share of everyone's data in dest
+std::unique_ptr<CinnamonParsedInstruction> CinnamonTextTraceReader::handle_a2a(const std::string &instruction) {
+    std::smatch match;
+	std::vector<CinnamonParsedValueType> dests;
+	std::vector<CinnamonParsedValueType> srcs;
+    if (std::regex_search(instruction.begin(), instruction.end(), match, a2a_regex)) {
+
+		std::optional<uint64_t>  syncID = std::stoull(match[1]);
+		std::optional<uint64_t>  syncSize = std::stoull(match[2]);
+		dests.push_back(parseValue(match[3]));
+		srcs.push_back(parseValue(match[5]));
+		auto baseIndex = -1;
+
+		auto cinnamonInstruction = std::make_unique<CinnamonParsedInstruction>(OpCode::A2a, baseIndex, syncID, syncSize, std::move(dests), std::move(srcs));
+		return std::move(cinnamonInstruction);
+    } else {
+        output->fatal(CALL_INFO, -1, "%s, Fatal: Invalid instruction %s in text reader.\n",
+                      getName().c_str(), instruction.c_str());
+    }
+
+	return nullptr;
+
+}
+
 std::unique_ptr<CinnamonParsedInstruction> CinnamonTextTraceReader::readNextInstruction(uint64_t instrId) {
 	std::string line;
 	if( getline (traceInputFile,line) ) {
+			bytesRead += line.size() + 1;
     //   std::cout << line << '\n';
 			size_t pos = std::string::npos;
 			std::string instruction_string = line;
@@ -273,6 +305,8 @@ std::unique_ptr<CinnamonParsedInstruction> CinnamonTextTraceReader::readNextInst
 				return handle_dis(line);
 			} else if(op == "joi") {
 				return handle_joi(line);
+			} else if(op == "a2a") {
+				return handle_a2a(line);
 			}
 			pos = line.find("|");
 			std::uint32_t baseIndex = -1;
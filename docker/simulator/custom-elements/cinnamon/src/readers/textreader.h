@@ -19,6 +19,9 @@ public:
 	// virtual std::unique_ptr<CinnamonInstruction> readNextInstruction(uint64_t instrId) override;
 	virtual std::unique_ptr<CinnamonParsedInstruction> readNextInstruction(uint64_t instrId) override;
 	// bool readNextInstr();
+	uint64_t traceBytes() const override { return traceSize; }
+	uint64_t traceBytesRead() const override { return bytesRead; }
+	std::string traceName() const override { return traceFileName; }
 
 	SST_ELI_REGISTER_SUBCOMPONENT(
 		CinnamonTextTraceReader,
@@ -37,6 +40,8 @@ private:
 	using OpCode = CinnamonInstructionOpCode;
 	std::string traceFileName;
 	std::ifstream traceInputFile;
+	uint64_t traceSize = 0;
+	uint64_t bytesRead = 0;
 	std::shared_ptr<SST::Output> output;
 	std::regex rsi_regex = std::regex("\\{(r[0-9]+, )*(r[0-9]+)\\}");
 	std::unique_ptr<CinnamonParsedInstruction> handle_rsi(const std::string & instruction);
@@ -50,6 +55,8 @@ private:
 	std::unique_ptr<CinnamonParsedInstruction> handle_dis(const std::string & instruction);
 	std::regex joi_regex = std::regex("@ ([0-9]+):([0-9]+) (r[0-9]+(\\[X\\])?)?: (r[0-9]+(\\[X\\])?)? \\| ([0-9]+)");
 	std::unique_ptr<CinnamonParsedInstruction> handle_joi(const std::string & instruction);
+	std::regex a2a_regex = std::regex("@ ([0-9]+):([0-9]+) (r[0-9]+(\\[X\\])?): (r[0-9]+(\\[X\\])?)");
+	std::unique_ptr<CinnamonParsedInstruction> handle_a2a(const std::string & instruction);
 
 };
 
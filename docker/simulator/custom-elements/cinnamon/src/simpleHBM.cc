@@ -0,0 +1,144 @@
+#include "sst/core/sst_config.h"
+#include <sst/core/unitAlgebra.h>
+#include <algorithm>
+#include <cmath>
+
+#include "simpleHBM.h"
+#include "utils/log.h"
+
+namespace SST {
+namespace Cinnamon {
+
+CinnamonSimpleHBM::CinnamonSimpleHBM(ComponentId_t id, Params &params, TimeConverter *&time, HandlerBase *&handler) : StandardMem(id, params, time, handler), handler(handler) {
+
+    const uint32_t output_level = (uint32_t)params.find<uint32_t>("verbose", 0);
+    output = std::make_shared<SST::Output>(SST::Output("CinnamonSimpleHBM[@p:@l]: ", output_level, 0, SST::Output::STDOUT));
+
+    numChannels = params.find<std::size_t>("numChannels", 8);
+    banksPerChannel = params.find<std::size_t>("banksPerChannel", 16);
+    interleaveSize = params.find<std::size_t>("interleaveSize", 256);
+    lineSize = params.find<Addr>("lineSize", 64);
+    if(numChannels == 0 || banksPerChannel == 0 || interleaveSize == 0) {
+        output->fatal(CALL_INFO, -1, "numChannels, banksPerChannel and interleaveSize must be non-zero\n");
+    }
+
+    UnitAlgebra channelBandwidth = params.find<UnitAlgebra>("channelBandwidth", "32GB/s");
+    UnitAlgebra latency = params.find<UnitAlgebra>("accessLatency", "100ns");
+    UnitAlgebra bankBusy = params.find<UnitAlgebra>("bankBusyTime", "30ns");
+    if(!channelBandwidth.hasUnits("B/s")) {
+        output->fatal(CALL_INFO, -1, "channelBandwidth must be specified in B/s, got %s\n", channelBandwidth.toString().c_str());
+    }
+    psPerByte = 1e12 / channelBandwidth.getDoubleValue();
+    accessLatency = std::llround(latency.getDoubleValue() * 1e12);
+    bankBusyTime = std::llround(bankBusy.getDoubleValue() * 1e12);
+
+    timeBase = getTimeConverter("1ps");
+    responseLink = configureSelfLink("response", "1ps", new Event::Handler<CinnamonSimpleHBM>(this, &CinnamonSimpleHBM::handleResponseEvent));
+    if(!responseLink) {
+        output->fatal(CALL_INFO, -1, "Unable to configure response link\n");
+    }
+
+    channels.resize(numChannels);
+    for(auto & channel: channels) {
+        channel.bankFreeAt.resize(banksPerChannel, 0);
+    }
+
+    CINNAMON_VERBOSE(output, 1, 0, "Configured %zu channels x %zu banks, %s per channel, %s access latency\n",
+                numChannels, banksPerChannel, channelBandwidth.toStringBestSI().c_str(), latency.toStringBestSI().c_str());
+}
+
+CinnamonSimpleHBM::~CinnamonSimpleHBM() {}
+
+void CinnamonSimpleHBM::init(unsigned int /* phase */) {}
+void CinnamonSimpleHBM::setup() {}
+
+void CinnamonSimpleHBM::finish() {
+    // The chiplet calls finish on its memory interfaces. Only report once
+    if(finished) {
+        return;
+    }
+    finished = true;
+    output->output("%s", printStats().c_str());
+}
+
+void CinnamonSimpleHBM::sendUntimedData(Request *req) {
+    delete req;
+}
+
+CinnamonSimpleHBM::Request * CinnamonSimpleHBM::recvUntimedData() {
+    return nullptr;
+}
+
+CinnamonSimpleHBM::Request * CinnamonSimpleHBM::poll() {
+    return nullptr;
+}
+
+CinnamonSimpleHBM::Addr CinnamonSimpleHBM::getLineSize() {
+    return lineSize;
+}
+
+void CinnamonSimpleHBM::setMemoryMappedAddressRegion(Addr /* start */, Addr /* size */) {}
+
+// Returns the time (in ps from now) at which an access completes and books its channel and bank
+SimTime_t CinnamonSimpleHBM::schedule(Addr addr, uint64_t size) {
+    SimTime_t now = getCurrentSimTime(timeBase);
+    auto & channel = channels[(addr / interleaveSize) % numChannels];
+    auto & bankFreeAt = channel.bankFreeAt[(addr / (interleaveSize * numChannels)) % banksPerChannel];
+
+    SimTime_t start = std::max({now, channel.freeAt, bankFreeAt});
+    SimTime_t transfer = static_cast<SimTime_t>(std::ceil(size * psPerByte));
+    channel.freeAt = start + transfer;
+    bankFreeAt = start + std::max(transfer, bankBusyTime);
+
+    channel.requests++;
+    channel.bytes += size;
+    channel.queueingDelay += start - now;
+
+    SimTime_t latency = (start - now) + transfer + accessLatency;
+    stats_.totalLatency += latency;
+    stats_.maxLatency = std::max(stats_.maxLatency, latency);
+    return latency;
+}
+
+void CinnamonSimpleHBM::send(Request *req) {
+    SimTime_t latency = 0;
+    if(auto read = dynamic_cast<Read *>(req)) {
+        latency = schedule(read->pAddr, read->size);
+        stats_.reads++;
+    } else if(auto write = dynamic_cast<Write *>(req)) {
+        latency = schedule(write->pAddr, write->size);
+        stats_.writes++;
+    } else {
+        output->fatal(CALL_INFO, -1, "%s: Unsupported request type. Only Read and Write are modelled\n", getName().c_str());
+    }
+
+    if(req->needsResponse()) {
+        responseLink->send(latency, new CinnamonMemoryResponseEvent(req->makeResponse()));
+    }
+    delete req;
+}
+
+void CinnamonSimpleHBM::handleResponseEvent(SST::Event *ev) {
+    std::unique_ptr<CinnamonMemoryResponseEvent> responseEvent(static_cast<CinnamonMemoryResponseEvent *>(ev));
+    (*handler)(responseEvent->response());
+}
+
+std::string CinnamonSimpleHBM::printStats() const {
+    std::stringstream s;
+    s << "Simple HBM: " << getName() << "\n";
+    s << "\tReads: " << stats_.reads << "\n";
+    s << "\tWrites: " << stats_.writes << "\n";
+    s << "\tMax Latency (ps): " << stats_.maxLatency << "\n";
+    auto requests = stats_.reads + stats_.writes;
+    s << "\tAverage Latency (ps): " << (requests ? double(stats_.totalLatency) / requests : 0.0) << "\n";
+    for(size_t i = 0; i < channels.size(); i++) {
+        auto & channel = channels[i];
+        s << "\tChannel " << i << " Requests: " << channel.requests;
+        s << " Bytes: " << channel.bytes;
+        s << " Average Queueing (ps): " << (channel.requests ? double(channel.queueingDelay) / channel.requests : 0.0) << "\n";
+    }
+    return s.str();
+}
+
+} // namespace Cinnamon
+} // namespace SST
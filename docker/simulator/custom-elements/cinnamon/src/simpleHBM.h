@@ -0,0 +1,113 @@
+#ifndef _H_SST_CINNAMON_SIMPLE_HBM
+#define _H_SST_CINNAMON_SIMPLE_HBM
+
+#include <vector>
+
+#include "sst/core/output.h"
+#include "sst/core/event.h"
+#include "sst/core/link.h"
+#include "sst/core/params.h"
+#include "sst/core/interfaces/stdMem.h"
+#include <sst/core/subcomponent.h>
+
+namespace SST {
+namespace Cinnamon {
+
+// Carries a response back to the requester through the response self link
+class CinnamonMemoryResponseEvent : public Event {
+public:
+    CinnamonMemoryResponseEvent(Interfaces::StandardMem::Request * response) : Event(), response_(response){};
+
+    Interfaces::StandardMem::Request * response() const {
+        return response_;
+    }
+
+private:
+    Interfaces::StandardMem::Request * response_;
+    CinnamonMemoryResponseEvent();
+        ImplementSerializable(SST::Cinnamon::CinnamonMemoryResponseEvent)
+};
+
+// Analytical HBM model that can replace memHierarchy in a chiplet's memory slot.
+// Each channel has a fixed bandwidth and each bank has a fixed busy time.
+// A request starts when its channel and bank are both free. It completes after
+// its transfer time plus a fixed access latency.
+// No cache, controller or DRAM timing state is simulated.
+class CinnamonSimpleHBM : public Interfaces::StandardMem {
+public:
+    CinnamonSimpleHBM(ComponentId_t id, Params &params, TimeConverter *&time, HandlerBase *&handler);
+    ~CinnamonSimpleHBM();
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        CinnamonSimpleHBM,
+        "cinnamon",
+        "SimpleHBM",
+        SST_ELI_ELEMENT_VERSION(1, 0, 0),
+        "Analytical HBM bandwidth/latency model",
+        SST::Interfaces::StandardMem);
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"numChannels", "Number of independent channels", "8"},
+        {"banksPerChannel", "Number of banks in each channel", "16"},
+        {"channelBandwidth", "Peak bandwidth of one channel", "32GB/s"},
+        {"accessLatency", "Fixed latency added to every request", "100ns"},
+        {"bankBusyTime", "Minimum time a bank is occupied by one access", "30ns"},
+        {"interleaveSize", "Channel interleaving granularity in bytes", "256"},
+        {"lineSize", "Line size reported to the requester", "64"})
+
+    void init(unsigned int phase) override;
+    void setup() override;
+    void finish() override;
+
+    void sendUntimedData(Request *req) override;
+    Request *recvUntimedData() override;
+    void send(Request *req) override;
+    Request *poll() override;
+    Addr getLineSize() override;
+    void setMemoryMappedAddressRegion(Addr start, Addr size) override;
+
+private:
+    CinnamonSimpleHBM();                          // Serialization only
+    CinnamonSimpleHBM(const CinnamonSimpleHBM &); // Do not impl.
+    void operator=(const CinnamonSimpleHBM &);    // Do not impl.
+
+    std::shared_ptr<SST::Output> output;
+    HandlerBase *handler;
+    TimeConverter *timeBase; // All internal times are in picoseconds
+    Link *responseLink;
+
+    std::size_t numChannels;
+    std::size_t banksPerChannel;
+    std::size_t interleaveSize;
+    Addr lineSize;
+    double psPerByte;
+    SimTime_t accessLatency;
+    SimTime_t bankBusyTime;
+    bool finished = false;
+
+    struct Channel {
+        SimTime_t freeAt = 0;
+        std::vector<SimTime_t> bankFreeAt;
+        uint64_t requests = 0;
+        uint64_t bytes = 0;
+        SimTime_t queueingDelay = 0;
+    };
+    std::vector<Channel> channels;
+
+    struct Stats {
+        uint64_t reads = 0;
+        uint64_t writes = 0;
+        SimTime_t totalLatency = 0;
+        SimTime_t maxLatency = 0;
+    } stats_;
+
+    SimTime_t schedule(Addr addr, uint64_t size);
+    void handleResponseEvent(SST::Event *ev);
+    std::string printStats() const;
+};
+
+} // namespace Cinnamon
+} // namespace SST
+
+#endif // _H_SST_CINNAMON_SIMPLE_HBM
@@ -0,0 +1,157 @@
+#include "sst/core/sst_config.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "stallStack.h"
+
+namespace SST {
+namespace Cinnamon {
+
+static const char * dispatchNames[] = {"Dispatched", "Vector Registers", "Scalar Registers", "BCU Registers", "Store Buffer", "Drained", "Other"};
+static const char * producerNames[] = {"Memory", "NTT", "Network", "Base Conversion", "Compute"};
+static const char * unitNames[] = {"Add", "Mul", "NTT", "Transpose", "Rot", "Evg", "BC Read", "BC Write", "BCU", "Rsv", "Mod", "Memory Slot", "Network"};
+
+static_assert(sizeof(dispatchNames) / sizeof(dispatchNames[0]) == static_cast<size_t>(CinnamonStallStack::Dispatch::NUM_REASONS));
+static_assert(sizeof(producerNames) / sizeof(producerNames[0]) == static_cast<size_t>(CinnamonStallStack::Producer::NUM_PRODUCERS));
+static_assert(sizeof(unitNames) / sizeof(unitNames[0]) == static_cast<size_t>(CinnamonStallStack::Unit::NUM_UNITS));
+
+static constexpr size_t numProducers = static_cast<size_t>(CinnamonStallStack::Producer::NUM_PRODUCERS);
+
+CinnamonStallStack::Producer CinnamonStallStack::producerOf(CinnamonInstructionOpCode opCode) {
+    using OpCode = CinnamonInstructionOpCode;
+    switch(opCode) {
+        case OpCode::LoadV:
+        case OpCode::LoadS:
+        case OpCode::Store:
+        case OpCode::Spill:
+            return Producer::Memory;
+        case OpCode::Ntt:
+        case OpCode::Int:
+        case OpCode::SuD:
+        case OpCode::Pl1:
+        case OpCode::Pl2:
+        case OpCode::Pl3:
+        case OpCode::Pl4:
+            return Producer::Ntt;
+        case OpCode::Dis:
+        case OpCode::Rcv:
+        case OpCode::Joi:
+        case OpCode::A2a:
+            return Producer::Network;
+        case OpCode::Bci:
+        case OpCode::BcW:
+        case OpCode::BcR:
+            return Producer::BaseConversion;
+        default:
+            return Producer::Compute;
+    }
+}
+
+// Columns are the dispatch reasons, then Issuing, Idle, the operand producers and the units
+std::string CinnamonStallStack::columnName(size_t column) {
+    if(column < issueColumn) {
+        return std::string("Dispatch ") + dispatchNames[column];
+    }
+    column -= issueColumn;
+    if(column == 0) {
+        return "Issue Issuing";
+    }
+    if(column == 1) {
+        return "Issue Idle";
+    }
+    column -= 2;
+    if(column < numProducers) {
+        return std::string("Issue Operands ") + producerNames[column];
+    }
+    return std::string("Issue Unit ") + unitNames[column - numProducers];
+}
+
+std::string CinnamonStallStack::csvHeader() {
+    std::stringstream s;
+    s << "cycle,chiplet";
+    for(size_t column = 0; column < numColumns; column++) {
+        auto name = columnName(column);
+        std::replace(name.begin(), name.end(), ' ', '_');
+        s << "," << name;
+    }
+    return s.str();
+}
+
+void CinnamonStallStack::configureTrace(std::ofstream * trace, SST::Cycle_t interval, uint32_t chipletID) {
+    this->trace = interval > 0 ? trace : nullptr;
+    this->interval = interval;
+    this->chipletID = chipletID;
+}
+
+void CinnamonStallStack::endQueue() {
+    if(queueIssued) {
+        cycleIssued = true;
+    } else if(queueUnit.has_value()) {
+        if(!cycleUnit.has_value()) {
+            cycleUnit = queueUnit;
+        }
+    } else if(queueProducer.has_value() && !cycleProducer.has_value()) {
+        cycleProducer = queueProducer;
+    }
+}
+
+void CinnamonStallStack::endCycle(SST::Cycle_t currentCycle, bool dispatched, bool drained) {
+    size_t dispatchColumn;
+    if(dispatched) {
+        dispatchColumn = static_cast<size_t>(Dispatch::Dispatched);
+    } else if(drained) {
+        dispatchColumn = static_cast<size_t>(Dispatch::Drained);
+    } else {
+        dispatchColumn = static_cast<size_t>(dispatchReason.value_or(Dispatch::Other));
+    }
+
+    size_t issue;
+    if(cycleIssued) {
+        issue = issueColumn;
+    } else if(cycleUnit.has_value()) {
+        issue = issueColumn + 2 + numProducers + static_cast<size_t>(cycleUnit.value());
+    } else if(cycleProducer.has_value()) {
+        issue = issueColumn + 2 + static_cast<size_t>(cycleProducer.value());
+    } else {
+        issue = issueColumn + 1;
+    }
+
+    total_[dispatchColumn]++;
+    total_[issue]++;
+    window_[dispatchColumn]++;
+    window_[issue]++;
+    cycles++;
+
+    dispatchReason.reset();
+    cycleIssued = false;
+    cycleUnit.reset();
+    cycleProducer.reset();
+
+    if(trace && currentCycle % interval == 0) {
+        *trace << currentCycle << "," << chipletID;
+        for(auto count: window_) {
+            *trace << "," << count;
+        }
+        *trace << "\n";
+        window_.fill(0);
+    }
+}
+
+std::string CinnamonStallStack::printStats() const {
+    std::stringstream s;
+    s << "Stall Cycles:\n";
+    for(size_t column = 0; column < numColumns; column++) {
+        if(total_[column] == 0) {
+            continue;
+        }
+        double percent = cycles ? (100.0 * total_[column]) / cycles : 0.0;
+        s << "\t" << columnName(column) << ": " << total_[column]
+          << " (" << std::fixed << std::setprecision(2) << percent << "%)\n";
+    }
+    return s.str();
+}
+
+} // Namespace Cinnamon
+} // Namespace SST
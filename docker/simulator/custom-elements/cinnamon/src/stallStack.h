@@ -0,0 +1,128 @@
+#ifndef _H_SST_CINNAMON_STALL_STACK
+#define _H_SST_CINNAMON_STALL_STACK
+
+#include <array>
+#include <fstream>
+#include <optional>
+#include <string>
+
+#include "sst/core/sst_types.h"
+#include "opcode.h"
+
+namespace SST {
+namespace Cinnamon {
+
+// CPI stack style attribution of every chiplet cycle.
+//
+// Dispatch is classified by why the fetched instruction could not be dispatched. Issue is classified
+// over all instruction queues, in priority order: some queue issued, some queue had a ready
+// instruction but no free unit of a type, some queue waited on an operand (attributed to the class of
+// the instruction producing it), or all queues were empty.
+class CinnamonStallStack {
+public:
+    enum class Dispatch : uint8_t {
+        Dispatched,
+        VectorRegisters,
+        ScalarRegisters,
+        BcuRegisters,   // Base conversion virtual registers
+        StoreBuffer,
+        Drained,        // Trace completed, waiting for the pipeline to empty
+        Other,
+        NUM_REASONS
+    };
+
+    enum class Producer : uint8_t {
+        Memory,
+        Ntt,
+        Network,
+        BaseConversion,
+        Compute,
+        NUM_PRODUCERS
+    };
+
+    enum class Unit : uint8_t {
+        Add,
+        Mul,
+        Ntt,
+        Transpose,
+        Rot,
+        Evg,
+        BcRead,
+        BcWrite,
+        Bcu,
+        Rsv,
+        Mod,
+        MemorySlot,     // Request slots of the memory ports
+        Network,        // Network port window, sync registration and ingress credits
+        NUM_UNITS
+    };
+
+    static Producer producerOf(CinnamonInstructionOpCode opCode);
+
+    // Sampled rows of per-window stall cycles are written to trace every interval cycles
+    void configureTrace(std::ofstream * trace, SST::Cycle_t interval, uint32_t chipletID);
+    static std::string csvHeader();
+
+    void dispatchBlocked(Dispatch reason) {
+        dispatchReason = reason;
+    }
+
+    // Called around the tick of each instruction queue
+    void beginQueue() {
+        queueIssued = false;
+        queueUnit.reset();
+        queueProducer.reset();
+    }
+    void issued() {
+        queueIssued = true;
+        issues_++;
+    }
+    void unitBusy(Unit unit) {
+        queueUnit = unit;
+    }
+    // Producer of an operand a queued instruction waits on. The first one since beginQueue() is kept
+    void operandsNotReady(std::optional<Producer> producer) {
+        if(!queueProducer.has_value()) {
+            queueProducer = producer;
+        }
+    }
+    void endQueue();
+
+    void endCycle(SST::Cycle_t currentCycle, bool dispatched, bool drained);
+    std::string printStats() const;
+
+    // Instructions issued to units so far
+    uint64_t issues() const {
+        return issues_;
+    }
+
+private:
+    static constexpr size_t issueColumn = static_cast<size_t>(Dispatch::NUM_REASONS);
+    static constexpr size_t numColumns = issueColumn + 2 + static_cast<size_t>(Producer::NUM_PRODUCERS) + static_cast<size_t>(Unit::NUM_UNITS);
+    using Counters = std::array<uint64_t, numColumns>;
+
+    static std::string columnName(size_t column);
+
+    std::optional<Dispatch> dispatchReason;
+    bool queueIssued = false;
+    std::optional<Unit> queueUnit;
+    std::optional<Producer> queueProducer;
+
+    bool cycleIssued = false;
+    std::optional<Unit> cycleUnit;
+    std::optional<Producer> cycleProducer;
+
+    Counters total_{};
+    Counters window_{};
+    SST::Cycle_t cycles = 0;
+    uint64_t issues_ = 0;
+
+    std::ofstream * trace = nullptr;
+    SST::Cycle_t interval = 0;
+    uint32_t chipletID = 0;
+};
+
+} // Namespace Cinnamon
+} // Namespace SST
+
+#endif // _H_SST_CINNAMON_STALL_STACK
@@ -0,0 +1,148 @@
+#include "sst/core/sst_config.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "termTraffic.h"
+
+namespace SST {
+namespace Cinnamon {
+
+CinnamonTermTraffic::Term & CinnamonTermTraffic::find(const std::string & term, bool isKey) {
+    auto & t = terms[term];
+    // Terms are marked as keys when an evkGen is turned into a load, which may follow earlier accesses
+    t.isKey |= isKey;
+    return t;
+}
+
+void CinnamonTermTraffic::load(const std::string & term, bool isKey, uint64_t bytes, bool onChip, uint64_t instruction, SST::Cycle_t cycle) {
+    auto & t = find(term, isKey);
+    if(t.loads > 0) {
+        uint64_t instructions = instruction - t.lastInstruction;
+        SST::Cycle_t cycles = cycle - t.lastCycle;
+        t.reuses++;
+        t.instructionDistance += instructions;
+        t.cycleDistance += cycles;
+        t.maxInstructionDistance = std::max(t.maxInstructionDistance, instructions);
+        t.maxCycleDistance = std::max(t.maxCycleDistance, cycles);
+    }
+    t.loads++;
+    t.lastInstruction = instruction;
+    t.lastCycle = cycle;
+    if(onChip) {
+        return;
+    }
+    if(t.memoryLoads > 0) {
+        t.reloads++;
+    }
+    if(t.spilled) {
+        t.refills++;
+        t.bytesRefilled += bytes;
+        t.spilled = false;
+    }
+    t.memoryLoads++;
+    t.bytesLoaded += bytes;
+}
+
+void CinnamonTermTraffic::store(const std::string & term, bool isKey, uint64_t bytes, bool spill) {
+    auto & t = find(term, isKey);
+    if(spill) {
+        t.spills++;
+        t.bytesSpilled += bytes;
+        t.spilled = true;
+    } else {
+        t.bytesStored += bytes;
+    }
+}
+
+std::vector<std::pair<const std::string *, const CinnamonTermTraffic::Term *>> CinnamonTermTraffic::sorted() const {
+    std::vector<std::pair<const std::string *, const Term *>> rows;
+    rows.reserve(terms.size());
+    for(auto & [name, t]: terms) {
+        rows.emplace_back(&name, &t);
+    }
+    std::sort(rows.begin(), rows.end(), [](const auto & a, const auto & b) {
+        auto bytesA = a.second->bytesLoaded + a.second->bytesSpilled + a.second->bytesStored;
+        auto bytesB = b.second->bytesLoaded + b.second->bytesSpilled + b.second->bytesStored;
+        if(bytesA != bytesB) {
+            return bytesA > bytesB;
+        }
+        return *a.first < *b.first;
+    });
+    return rows;
+}
+
+std::string CinnamonTermTraffic::printStats(size_t entries) const {
+    uint64_t bytesLoaded[2] = {0, 0};
+    uint64_t bytesReloaded[2] = {0, 0};
+    uint64_t bytesSpilled = 0;
+    uint64_t bytesRefilled = 0;
+    for(auto & [name, t]: terms) {
+        bytesLoaded[t.isKey] += t.bytesLoaded;
+        // Loads of a term have the same size, so reloaded bytes are the share of loads that were reloads
+        if(t.memoryLoads > 0) {
+            bytesReloaded[t.isKey] += t.bytesLoaded / t.memoryLoads * t.reloads;
+        }
+        bytesSpilled += t.bytesSpilled;
+        bytesRefilled += t.bytesRefilled;
+    }
+
+    std::stringstream s;
+    s << "Term Traffic:\n";
+    s << "\tTerms: " << terms.size() << "\n";
+    s << "\tKey Bytes Loaded: " << bytesLoaded[1] << " (Reloaded: " << bytesReloaded[1] << ")\n";
+    s << "\tData Bytes Loaded: " << bytesLoaded[0] << " (Reloaded: " << bytesReloaded[0] << ")\n";
+    s << "\tBytes Spilled: " << bytesSpilled << "\n";
+    s << "\tBytes Refilled: " << bytesRefilled << "\n";
+
+    auto rows = sorted();
+    if(entries > 0 && rows.size() > entries) {
+        rows.resize(entries);
+    }
+    s << "\t" << std::left << std::setw(32) << "Term" << std::right
+      << std::setw(6) << "Class"
+      << std::setw(14) << "Loaded"
+      << std::setw(8) << "Loads"
+      << std::setw(8) << "Reloads"
+      << std::setw(14) << "Spilled"
+      << std::setw(14) << "Refilled"
+      << std::setw(14) << "Stored"
+      << std::setw(12) << "Reuse Insts"
+      << std::setw(14) << "Reuse Cycles" << "\n";
+    for(auto & [name, t]: rows) {
+        s << "\t" << std::left << std::setw(32) << *name << std::right
+          << std::setw(6) << (t->isKey ? "key" : "data")
+          << std::setw(14) << t->bytesLoaded
+          << std::setw(8) << t->loads
+          << std::setw(8) << t->reloads
+          << std::setw(14) << t->bytesSpilled
+          << std::setw(14) << t->bytesRefilled
+          << std::setw(14) << t->bytesStored
+          << std::setw(12) << (t->reuses ? t->instructionDistance / t->reuses : 0)
+          << std::setw(14) << (t->reuses ? t->cycleDistance / t->reuses : 0) << "\n";
+    }
+    return s.str();
+}
+
+std::string CinnamonTermTraffic::csvHeader() {
+    return "chiplet,term,class,bytes_loaded,loads,memory_loads,reloads,refills,bytes_refilled,spills,bytes_spilled,bytes_stored,"
+           "reuses,mean_reuse_instructions,max_reuse_instructions,mean_reuse_cycles,max_reuse_cycles";
+}
+
+void CinnamonTermTraffic::writeCsv(std::ostream & csv, uint32_t chipletID) const {
+    for(auto & [name, t]: sorted()) {
+        csv << chipletID << "," << *name << "," << (t->isKey ? "key" : "data")
+            << "," << t->bytesLoaded << "," << t->loads << "," << t->memoryLoads << "," << t->reloads
+            << "," << t->refills << "," << t->bytesRefilled << "," << t->spills << "," << t->bytesSpilled
+            << "," << t->bytesStored << "," << t->reuses
+            << "," << (t->reuses ? static_cast<double>(t->instructionDistance) / t->reuses : 0.0)
+            << "," << t->maxInstructionDistance
+            << "," << (t->reuses ? static_cast<double>(t->cycleDistance) / t->reuses : 0.0)
+            << "," << t->maxCycleDistance << "\n";
+    }
+}
+
+} // Namespace Cinnamon
+} // Namespace SST
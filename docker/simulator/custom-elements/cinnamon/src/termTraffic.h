@@ -0,0 +1,68 @@
+#ifndef _H_SST_CINNAMON_TERM_TRAFFIC
+#define _H_SST_CINNAMON_TERM_TRAFFIC
+
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sst/core/sst_types.h"
+
+namespace SST {
+namespace Cinnamon {
+
+// Memory traffic of each trace term, accounted when its memory instruction is dispatched.
+//
+// A load is either sent to memory or served on chip by a pending store, spill or load of the same
+// address. Loads sent to memory after the first are reloads. Those that follow a spill of the term
+// are refills. Reuse distance is measured between consecutive loads of a term, whether or not they
+// reached memory. Scalar loads count as sent to memory even if the memory unit's scalar cache hits,
+// and as served on chip when modelScalarLoads is off.
+class CinnamonTermTraffic {
+public:
+    void load(const std::string & term, bool isKey, uint64_t bytes, bool onChip, uint64_t instruction, SST::Cycle_t cycle);
+    void store(const std::string & term, bool isKey, uint64_t bytes, bool spill);
+
+    bool empty() const {
+        return terms.empty();
+    }
+
+    // Terms with the most memory traffic first. entries limits the number of rows (0 prints all)
+    std::string printStats(size_t entries) const;
+    static std::string csvHeader();
+    void writeCsv(std::ostream & csv, uint32_t chipletID) const;
+
+private:
+    struct Term {
+        bool isKey = false;
+        uint64_t loads = 0;          // Load instructions, including those served on chip
+        uint64_t memoryLoads = 0;
+        uint64_t bytesLoaded = 0;
+        uint64_t reloads = 0;
+        uint64_t refills = 0;
+        uint64_t bytesRefilled = 0;
+        uint64_t spills = 0;
+        uint64_t bytesSpilled = 0;
+        uint64_t bytesStored = 0;
+        bool spilled = false;        // Spilled since the last load sent to memory
+
+        uint64_t lastInstruction = 0;
+        SST::Cycle_t lastCycle = 0;
+        uint64_t reuses = 0;
+        uint64_t instructionDistance = 0; // Sum over reuses
+        uint64_t cycleDistance = 0;
+        uint64_t maxInstructionDistance = 0;
+        SST::Cycle_t maxCycleDistance = 0;
+    };
+
+    Term & find(const std::string & term, bool isKey);
+    std::vector<std::pair<const std::string *, const Term *>> sorted() const;
+
+    std::unordered_map<std::string, Term> terms;
+};
+
+} // Namespace Cinnamon
+} // Namespace SST
+
+#endif // _H_SST_CINNAMON_TERM_TRAFFIC
@@ -0,0 +1,499 @@
+#include "sst/core/sst_config.h"
+#include <sst/core/unitAlgebra.h>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "topology.h"
+#include "utils/log.h"
+
+namespace SST {
+namespace Cinnamon {
+
+CinnamonTopology::CinnamonTopology(const Params & params, std::shared_ptr<SST::Output> output, std::size_t numChiplets) : output(output), numChiplets(numChiplets), numNodes(numChiplets) {
+
+    auto kindString = params.find<std::string>("topology", "ideal");
+    if(kindString == "ideal") {
+        kind_ = Kind::Ideal;
+    } else if(kindString == "ring") {
+        kind_ = Kind::Ring;
+    } else if(kindString == "mesh") {
+        kind_ = Kind::Mesh;
+    } else if(kindString == "torus") {
+        kind_ = Kind::Torus;
+    } else if(kindString == "fullyConnected") {
+        kind_ = Kind::FullyConnected;
+    } else if(kindString == "fatTree") {
+        kind_ = Kind::FatTree;
+    } else if(kindString == "hierarchical") {
+        kind_ = Kind::Hierarchical;
+    } else {
+        output->fatal(CALL_INFO, -1, "Unknown topology: %s\n", kindString.c_str());
+    }
+
+    UnitAlgebra linkBW = params.find<UnitAlgebra>("linkBW", "256GB/s");
+    UnitAlgebra latency = params.find<UnitAlgebra>("hopLatency", "5ns");
+    if(!linkBW.hasUnits("B/s")) {
+        output->fatal(CALL_INFO, -1, "linkBW must be specified in B/s, got %s\n", linkBW.toString().c_str());
+    }
+    psPerByte = 1e12 / linkBW.getDoubleValue();
+    hopLatency = std::llround(latency.getDoubleValue() * 1e12);
+    packetSize = params.find<uint64_t>("packetSize", 0);
+    flitSize = params.find<uint64_t>("flitSize", 0);
+    streamingReceive = params.find<bool>("streamingReceive", false);
+
+    auto reductionString = params.find<std::string>("reduction", "none");
+    if(reductionString == "none") {
+        reduction_ = Reduction::None;
+    } else if(reductionString == "endpoint") {
+        reduction_ = Reduction::Endpoint;
+    } else if(reductionString == "inNetwork") {
+        reduction_ = Reduction::InNetwork;
+    } else {
+        output->fatal(CALL_INFO, -1, "Unknown reduction: %s\n", reductionString.c_str());
+    }
+    const char * prefix = reduction_ == Reduction::InNetwork ? "switchAdder" : "endpointAdder";
+    UnitAlgebra adderBW = params.find<UnitAlgebra>(std::string(prefix) + "BW", reduction_ == Reduction::InNetwork ? "512GB/s" : "256GB/s");
+    UnitAlgebra adderLatency = params.find<UnitAlgebra>(std::string(prefix) + "Latency", reduction_ == Reduction::InNetwork ? "2ns" : "5ns");
+    if(!adderBW.hasUnits("B/s")) {
+        output->fatal(CALL_INFO, -1, "%sBW must be specified in B/s, got %s\n", prefix, adderBW.toString().c_str());
+    }
+    adderPsPerByte = 1e12 / adderBW.getDoubleValue();
+    adderLatency_ = std::llround(adderLatency.getDoubleValue() * 1e12);
+    if(kind_ == Kind::Ideal && reduction_ != Reduction::None) {
+        output->fatal(CALL_INFO, -1, "reduction = %s needs an explicit topology\n", reductionString.c_str());
+    }
+
+    if(packetSize && flitSize > packetSize) {
+        output->fatal(CALL_INFO, -1, "flitSize (%" PRIu64 ") must not exceed packetSize (%" PRIu64 ")\n", flitSize, packetSize);
+    }
+
+    switch(kind_) {
+        case Kind::Ideal:
+            break;
+        case Kind::Ring:
+            meshColumns = numChiplets;
+            meshRows = 1;
+            for(std::size_t i = 0; i < numChiplets; i++) {
+                addLink(i, (i + 1) % numChiplets, psPerByte);
+            }
+            break;
+        case Kind::Mesh:
+        case Kind::Torus:
+            meshColumns = params.find<std::size_t>("meshColumns", std::ceil(std::sqrt(numChiplets)));
+            if(meshColumns == 0 || numChiplets % meshColumns != 0) {
+                output->fatal(CALL_INFO, -1, "meshColumns (%zu) must evenly divide the number of chiplets (%zu)\n", meshColumns, numChiplets);
+            }
+            meshRows = numChiplets / meshColumns;
+            for(std::size_t r = 0; r < meshRows; r++) {
+                for(std::size_t c = 0; c < meshColumns; c++) {
+                    auto node = r * meshColumns + c;
+                    if(c + 1 < meshColumns || (kind_ == Kind::Torus && meshColumns > 1)) {
+                        addLink(node, r * meshColumns + (c + 1) % meshColumns, psPerByte);
+                    }
+                    if(r + 1 < meshRows || (kind_ == Kind::Torus && meshRows > 1)) {
+                        addLink(node, ((r + 1) % meshRows) * meshColumns + c, psPerByte);
+                    }
+                }
+            }
+            break;
+        case Kind::FullyConnected:
+            for(std::size_t i = 0; i < numChiplets; i++) {
+                for(std::size_t j = i + 1; j < numChiplets; j++) {
+                    addLink(i, j, psPerByte);
+                }
+            }
+            break;
+        case Kind::FatTree: {
+            switchRadix = params.find<std::size_t>("switchRadix", 8);
+            double taper = params.find<double>("fatTreeTaper", 1.0);
+            if(switchRadix == 0 || taper <= 0) {
+                output->fatal(CALL_INFO, -1, "switchRadix and fatTreeTaper must be positive\n");
+            }
+            std::size_t numLeaves = (numChiplets + switchRadix - 1) / switchRadix;
+            std::size_t spine = numChiplets + numLeaves;
+            numNodes = numChiplets + numLeaves + (numLeaves > 1 ? 1 : 0);
+            for(std::size_t i = 0; i < numChiplets; i++) {
+                addLink(i, numChiplets + i / switchRadix, psPerByte);
+            }
+            if(numLeaves > 1) {
+                // Uplinks carry the traffic of every chiplet under the leaf, divided by the taper
+                for(std::size_t l = 0; l < numLeaves; l++) {
+                    std::size_t leafChiplets = std::min(switchRadix, numChiplets - l * switchRadix);
+                    addLink(numChiplets + l, spine, psPerByte * taper / leafChiplets);
+                }
+            }
+            groupSizes_.push_back(switchRadix);
+            break;
+        }
+        case Kind::Hierarchical: {
+            // Tier 0: chiplet <-> package switch (die-to-die fabric, linkBW / hopLatency)
+            // Tier 1: package switch <-> board switch, or the system switch without boards
+            // Tier 2: board switch <-> system switch
+            std::size_t chipletsPerPackage = params.find<std::size_t>("chipletsPerPackage", 16);
+            std::size_t packagesPerBoard = params.find<std::size_t>("packagesPerBoard", 0);
+            if(chipletsPerPackage == 0 || numChiplets % chipletsPerPackage != 0) {
+                output->fatal(CALL_INFO, -1, "chipletsPerPackage (%zu) must evenly divide the number of chiplets (%zu)\n", chipletsPerPackage, numChiplets);
+            }
+            std::size_t numPackages = numChiplets / chipletsPerPackage;
+            if(packagesPerBoard && numPackages % packagesPerBoard != 0) {
+                output->fatal(CALL_INFO, -1, "packagesPerBoard (%zu) must evenly divide the number of packages (%zu)\n", packagesPerBoard, numPackages);
+            }
+            std::size_t numBoards = packagesPerBoard ? numPackages / packagesPerBoard : 0;
+
+            UnitAlgebra packageBW = params.find<UnitAlgebra>("packageLinkBW", "64GB/s");
+            UnitAlgebra packageLatency = params.find<UnitAlgebra>("packageHopLatency", "50ns");
+            UnitAlgebra boardBW = params.find<UnitAlgebra>("boardLinkBW", "25GB/s");
+            UnitAlgebra boardLatency = params.find<UnitAlgebra>("boardHopLatency", "500ns");
+            if(!packageBW.hasUnits("B/s") || !boardBW.hasUnits("B/s")) {
+                output->fatal(CALL_INFO, -1, "packageLinkBW and boardLinkBW must be specified in B/s\n");
+            }
+            double packagePsPerByte = 1e12 / packageBW.getDoubleValue();
+            SimTime_t packageHop = std::llround(packageLatency.getDoubleValue() * 1e12);
+            double boardPsPerByte = 1e12 / boardBW.getDoubleValue();
+            SimTime_t boardHop = std::llround(boardLatency.getDoubleValue() * 1e12);
+
+            std::size_t firstPackage = numChiplets;
+            std::size_t firstBoard = firstPackage + numPackages;
+            std::size_t system = firstBoard + numBoards;
+            numNodes = system + 1;
+            parent.assign(numNodes, numNodes);
+            for(std::size_t i = 0; i < numChiplets; i++) {
+                parent[i] = firstPackage + i / chipletsPerPackage;
+                addLink(i, parent[i], psPerByte, hopLatency, 0);
+            }
+            for(std::size_t p = 0; p < numPackages; p++) {
+                parent[firstPackage + p] = numBoards ? firstBoard + p / packagesPerBoard : system;
+                addLink(firstPackage + p, parent[firstPackage + p], packagePsPerByte, packageHop, 1);
+            }
+            for(std::size_t b = 0; b < numBoards; b++) {
+                parent[firstBoard + b] = system;
+                addLink(firstBoard + b, system, boardPsPerByte, boardHop, 2);
+            }
+            groupSizes_.push_back(chipletsPerPackage);
+            if(numBoards) {
+                groupSizes_.push_back(chipletsPerPackage * packagesPerBoard);
+            }
+            CINNAMON_VERBOSE(output, 1, 0, "Hierarchy: %zu packages of %zu chiplets, %zu boards. Package Links: %s, %s. Board Links: %s, %s\n",
+                        numPackages, chipletsPerPackage, numBoards, packageBW.toStringBestSI().c_str(), packageLatency.toStringBestSI().c_str(),
+                        boardBW.toStringBestSI().c_str(), boardLatency.toStringBestSI().c_str());
+            break;
+        }
+    }
+
+    adders.resize(numNodes);
+    routes.resize(numChiplets * numChiplets);
+    if(kind_ != Kind::Ideal) {
+        for(std::size_t src = 0; src < numChiplets; src++) {
+            for(std::size_t dst = 0; dst < numChiplets; dst++) {
+                routes[src * numChiplets + dst] = computeRoute(src, dst);
+            }
+        }
+    }
+
+    CINNAMON_VERBOSE(output, 1, 0, "Topology: %s, Chiplets: %zu, Nodes: %zu, Links: %zu, Link BW: %s, Hop Latency: %s\n",
+                getKindString(kind_).c_str(), numChiplets, numNodes, links.size(), linkBW.toStringBestSI().c_str(), latency.toStringBestSI().c_str());
+}
+
+void CinnamonTopology::addLink(std::size_t a, std::size_t b, double linkPsPerByte) {
+    addLink(a, b, linkPsPerByte, hopLatency, 0);
+}
+
+void CinnamonTopology::addLink(std::size_t a, std::size_t b, double linkPsPerByte, SimTime_t latency, std::size_t tier) {
+    if(a == b || linkIndex.find({a, b}) != linkIndex.end()) {
+        return;
+    }
+    linkIndex[{a, b}] = links.size();
+    links.push_back({a, b, linkPsPerByte, latency, tier});
+    linkIndex[{b, a}] = links.size();
+    links.push_back({b, a, linkPsPerByte, latency, tier});
+}
+
+std::vector<std::size_t> CinnamonTopology::treeRoute(std::size_t src, std::size_t dst) const {
+    std::vector<std::size_t> up;
+    std::vector<std::size_t> down;
+    std::size_t a = src;
+    std::size_t b = dst;
+    // Nodes are numbered tier by tier, so the lower-numbered side of the walk is never above the other
+    while(a != b) {
+        if(a < b) {
+            up.push_back(link(a, parent[a]));
+            a = parent[a];
+        } else {
+            down.push_back(link(parent[b], b));
+            b = parent[b];
+        }
+    }
+    up.insert(up.end(), down.rbegin(), down.rend());
+    return up;
+}
+
+std::size_t CinnamonTopology::link(std::size_t from, std::size_t to) const {
+    auto it = linkIndex.find({from, to});
+    if(it == linkIndex.end()) {
+        output->fatal(CALL_INFO, -1, "No link from node %zu to node %zu in %s topology\n", from, to, getKindString(kind_).c_str());
+    }
+    return it->second;
+}
+
+void CinnamonTopology::walkRing(std::vector<std::size_t> & route, std::size_t & node, std::size_t from, std::size_t to, std::size_t n, std::size_t stride, bool wrap) const {
+    if(from == to) {
+        return;
+    }
+    std::size_t forward = (to + n - from) % n;
+    bool positive = wrap ? (forward <= n - forward) : (to > from);
+    std::size_t steps = wrap ? std::min(forward, n - forward) : (positive ? to - from : from - to);
+    std::size_t pos = from;
+    for(std::size_t s = 0; s < steps; s++) {
+        std::size_t nextPos = positive ? (pos + 1) % n : (pos + n - 1) % n;
+        std::size_t next = node - pos * stride + nextPos * stride;
+        route.push_back(link(node, next));
+        node = next;
+        pos = nextPos;
+    }
+}
+
+std::vector<std::size_t> CinnamonTopology::computeRoute(std::size_t src, std::size_t dst) const {
+    std::vector<std::size_t> route;
+    if(src == dst) {
+        return route;
+    }
+    switch(kind_) {
+        case Kind::Ideal:
+            break;
+        case Kind::Ring:
+        case Kind::Mesh:
+        case Kind::Torus: {
+            bool wrap = kind_ != Kind::Mesh;
+            std::size_t node = src;
+            walkRing(route, node, src % meshColumns, dst % meshColumns, meshColumns, 1, wrap);
+            walkRing(route, node, src / meshColumns, dst / meshColumns, meshRows, meshColumns, wrap);
+            assert(node == dst);
+            break;
+        }
+        case Kind::FullyConnected:
+            route.push_back(link(src, dst));
+            break;
+        case Kind::Hierarchical:
+            route = treeRoute(src, dst);
+            break;
+        case Kind::FatTree: {
+            std::size_t srcLeaf = numChiplets + src / switchRadix;
+            std::size_t dstLeaf = numChiplets + dst / switchRadix;
+            route.push_back(link(src, srcLeaf));
+            if(srcLeaf != dstLeaf) {
+                std::size_t spine = numNodes - 1;
+                route.push_back(link(srcLeaf, spine));
+                route.push_back(link(spine, dstLeaf));
+            }
+            route.push_back(link(dstLeaf, dst));
+            break;
+        }
+    }
+    return route;
+}
+
+SimTime_t CinnamonTopology::reserve(std::size_t src, std::size_t dst, uint64_t size, SimTime_t now) {
+    return sendOver(routes[src * numChiplets + dst], size, now, streamingReceive);
+}
+
+SimTime_t CinnamonTopology::sendOver(const std::vector<std::size_t> & route, uint64_t size, SimTime_t now, bool stream) {
+    uint64_t packet = (packetSize && packetSize < size) ? packetSize : size;
+    uint64_t numPackets = packet ? (size + packet - 1) / packet : 1;
+    SimTime_t packetTime = static_cast<SimTime_t>(std::ceil(packet * psPerByte));
+    SimTime_t lastArrival = now;
+    SimTime_t streamStart = now;
+    stats_.transfers++;
+    stats_.packets += numPackets;
+
+    for(uint64_t p = 0; p < numPackets; p++) {
+        uint64_t bytes = std::min(packet, size - p * packet);
+        SimTime_t head = now; // Time the first flit is ready to enter the next link
+        SimTime_t tail = now; // Time the last flit is ready to enter the next link
+        for(auto linkID: route) {
+            auto & l = links[linkID];
+            SimTime_t transfer = static_cast<SimTime_t>(std::ceil(bytes * l.psPerByte));
+            SimTime_t start = std::max(head, l.freeAt);
+            // The tail cannot overtake itself on a faster link
+            SimTime_t end = std::max(start + transfer, tail);
+            l.freeAt = end;
+            l.transfers++;
+            l.bytes += bytes;
+            l.busyTime += transfer;
+            l.queueingDelay += start - head;
+            SimTime_t forward = transfer;
+            if(flitSize && flitSize < bytes) {
+                forward = static_cast<SimTime_t>(std::ceil(flitSize * l.psPerByte));
+            }
+            head = start + forward + l.latency;
+            tail = end + l.latency;
+        }
+        lastArrival = std::max(lastArrival, tail);
+        // A consumer that starts at streamStart reads packet p at streamStart + p * packetTime
+        SimTime_t lead = p * packetTime;
+        if(tail > lead) {
+            streamStart = std::max(streamStart, tail - lead);
+        }
+    }
+
+    if(!stream) {
+        return lastArrival;
+    }
+    stats_.streamingLead += lastArrival - streamStart;
+    return streamStart;
+}
+
+SimTime_t CinnamonTopology::combine(std::size_t node, SimTime_t own, SimTime_t incoming, uint64_t size) {
+    SimTime_t ready = std::max(own, incoming);
+    if(reduction_ == Reduction::None) {
+        return ready;
+    }
+    auto & adder = adders[node];
+    SimTime_t start = std::max(ready, adder.freeAt);
+    SimTime_t busy = static_cast<SimTime_t>(std::ceil(size * adderPsPerByte));
+    adder.freeAt = start + busy;
+    adder.reductions++;
+    adder.busyTime += busy;
+    return start + busy + adderLatency_;
+}
+
+SimTime_t CinnamonTopology::reserveReduction(std::size_t dst, const std::vector<std::pair<int,SimTime_t>> & contributions, uint64_t size) {
+    // Routes are destination based, so the routes of all contributors form a tree rooted at dst.
+    // Every node forwards one partial sum over its link towards dst once all of its inputs have been added
+    std::map<std::size_t,std::size_t> nextLink;
+    std::map<std::size_t,std::size_t> depth;
+    std::map<std::size_t,SimTime_t> ready;
+    std::map<std::size_t,bool> holdsPartial;
+    for(auto & [src, time] : contributions) {
+        const auto & route = routes[src * numChiplets + dst];
+        for(std::size_t k = 0; k < route.size(); k++) {
+            auto node = links[route[k]].from;
+            nextLink[node] = route[k];
+            depth[node] = route.size() - k;
+        }
+        ready[src] = holdsPartial[src] ? std::max(ready[src], time) : time;
+        holdsPartial[src] = true;
+    }
+
+    std::vector<std::pair<std::size_t,std::size_t>> order; // (depth, node), deepest first
+    for(auto & [node, d] : depth) {
+        order.emplace_back(d, node);
+    }
+    std::sort(order.rbegin(), order.rend());
+
+    for(auto & [d, node] : order) {
+        if(!holdsPartial[node]) {
+            continue;
+        }
+        auto linkID = nextLink[node];
+        SimTime_t arrival = sendOver({linkID}, size, ready[node], false);
+        auto to = links[linkID].to;
+        if(holdsPartial[to]) {
+            ready[to] = combine(to, ready[to], arrival, size);
+        } else {
+            ready[to] = arrival;
+            holdsPartial[to] = true;
+        }
+    }
+    return ready[dst];
+}
+
+std::string CinnamonTopology::getReductionString(Reduction reduction) {
+    switch(reduction) {
+        case Reduction::None:
+            return "None";
+        case Reduction::Endpoint:
+            return "Endpoint";
+        case Reduction::InNetwork:
+            return "InNetwork";
+    }
+    return "Unknown";
+}
+
+std::string CinnamonTopology::getKindString(Kind kind) {
+    switch(kind) {
+        case Kind::Ideal:
+            return "Ideal";
+        case Kind::Ring:
+            return "Ring";
+        case Kind::Mesh:
+            return "Mesh";
+        case Kind::Torus:
+            return "Torus";
+        case Kind::FullyConnected:
+            return "FullyConnected";
+        case Kind::FatTree:
+            return "FatTree";
+        case Kind::Hierarchical:
+            return "Hierarchical";
+    }
+    return "Unknown";
+}
+
+std::string CinnamonTopology::printStats(SimTime_t elapsed) const {
+    std::stringstream s;
+    s << "\tTopology: " << getKindString(kind_) << "\n";
+    if(links.empty()) {
+        return s.str();
+    }
+    uint64_t bytes = 0;
+    SimTime_t busyTime = 0;
+    SimTime_t queueingDelay = 0;
+    std::size_t busiest = 0;
+    for(std::size_t i = 0; i < links.size(); i++) {
+        bytes += links[i].bytes;
+        busyTime += links[i].busyTime;
+        queueingDelay += links[i].queueingDelay;
+        if(links[i].busyTime > links[busiest].busyTime) {
+            busiest = i;
+        }
+    }
+    s << "\tLinks: " << links.size() << "\n";
+    s << "\tTransfers: " << stats_.transfers << "\n";
+    s << "\tPackets: " << stats_.packets << "\n";
+    if(streamingReceive) {
+        s << "\tStreaming Lead (ps): " << stats_.streamingLead << "\n";
+    }
+    s << "\tLink Bytes: " << bytes << "\n";
+    if(reduction_ != Reduction::None) {
+        uint64_t reductions = 0;
+        SimTime_t adderBusy = 0;
+        for(auto & adder : adders) {
+            reductions += adder.reductions;
+            adderBusy += adder.busyTime;
+        }
+        s << "\tReduction: " << getReductionString(reduction_) << "\n";
+        s << "\tReductions: " << reductions << "\n";
+        s << "\tAdder Busy Time (ps): " << adderBusy << "\n";
+    }
+    s << "\tLink Queueing Delay (ps): " << queueingDelay << "\n";
+    if(kind_ == Kind::Hierarchical) {
+        for(std::size_t tier = 0; tier <= groupSizes_.size(); tier++) {
+            uint64_t tierBytes = 0;
+            SimTime_t tierBusy = 0;
+            std::size_t tierLinks = 0;
+            for(auto & l : links) {
+                if(l.tier == tier) {
+                    tierBytes += l.bytes;
+                    tierBusy += l.busyTime;
+                    tierLinks++;
+                }
+            }
+            s << "\tTier " << tier << " Links: " << tierLinks << " Bytes: " << tierBytes;
+            if(elapsed && tierLinks) {
+                s << " Average Utilisation %: " << (100.0 * tierBusy) / (double(elapsed) * tierLinks);
+            }
+            s << "\n";
+        }
+    }
+    if(elapsed) {
+        s << "\tAverage Link Utilisation %: " << (100.0 * busyTime) / (double(elapsed) * links.size()) << "\n";
+        s << "\tBusiest Link: " << links[busiest].from << "->" << links[busiest].to;
+        s << " Utilisation %: " << (100.0 * links[busiest].busyTime) / elapsed;
+        s << " Packets: " << links[busiest].transfers << "\n";
+    }
+    return s.str();
+}
+
+} // Namespace Cinnamon
+} // Namespace SST
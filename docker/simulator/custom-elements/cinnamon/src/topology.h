@@ -0,0 +1,154 @@
+#ifndef _H_SST_CINNAMON_TOPOLOGY
+#define _H_SST_CINNAMON_TOPOLOGY
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sst/core/output.h"
+#include "sst/core/params.h"
+
+namespace SST {
+namespace Cinnamon {
+
+// Explicit chiplet interconnect used by CinnamonNetwork.
+//
+// Nodes 0..numChiplets-1 are chiplets, higher node IDs are switches. Every
+// physical connection is modelled as two unidirectional links, each with its
+// own bandwidth and a fixed per-hop latency. Routes are deterministic and
+// computed once at construction. A transfer books every link on its route in
+// order, so concurrent collectives that share a link queue behind each other.
+// All times are in picoseconds.
+class CinnamonTopology {
+public:
+    enum class Kind {
+        Ideal,          // No links. The network keeps its original log2(span) hop model
+        Ring,           // Bidirectional ring, shortest direction
+        Mesh,           // 2D mesh, XY dimension-ordered routing
+        Torus,          // 2D torus, XY routing taking the shorter way around each dimension
+        FullyConnected, // A direct link between every pair of chiplets
+        FatTree,        // Chiplets hang off leaf switches joined by a spine switch
+        Hierarchical    // Chiplets share a package switch, packages (and boards) are joined by slower tiers
+    };
+
+    // Where the partial sums of an aggregation are added
+    enum class Reduction {
+        None,     // Additions are free
+        Endpoint, // The receiving chiplet adds each incoming partial sum
+        InNetwork // Routers and switches add partial sums on the way, so each link carries one limb
+    };
+
+    CinnamonTopology(const Params & params, std::shared_ptr<SST::Output> output, std::size_t numChiplets);
+
+    // Books the links from src to dst for a transfer of size bytes that is ready at time now.
+    // Returns the time at which the last byte arrives at dst. With streamingReceive, returns the
+    // earliest time a consumer at dst can start and read the packets at link rate without stalling
+    SimTime_t reserve(std::size_t src, std::size_t dst, uint64_t size, SimTime_t now);
+
+    // Returns the time at which node holds the sum of a partial it has at own and one that arrives at incoming
+    SimTime_t combine(std::size_t node, SimTime_t own, SimTime_t incoming, uint64_t size);
+
+    // In-network reduction of the contributions (chiplet, ready time) to dst. Returns the time dst holds the sum
+    SimTime_t reserveReduction(std::size_t dst, const std::vector<std::pair<int,SimTime_t>> & contributions, uint64_t size);
+
+    std::size_t hops(std::size_t src, std::size_t dst) const {
+        return routes[src * numChiplets + dst].size();
+    }
+
+    Kind kind() const {
+        return kind_;
+    }
+
+    Reduction reduction() const {
+        return reduction_;
+    }
+
+    // Sizes of the chiplet groups that share a switch, innermost first (e.g. chiplets per package, per board)
+    const std::vector<std::size_t> & groupSizes() const {
+        return groupSizes_;
+    }
+
+    std::size_t numLinks() const {
+        return links.size();
+    }
+
+    // Name of a link as <from>_<to>
+    std::string linkName(std::size_t linkID) const {
+        return std::to_string(links[linkID].from) + "_" + std::to_string(links[linkID].to);
+    }
+
+    // Total busy time booked on a link so far
+    SimTime_t linkBusyTime(std::size_t linkID) const {
+        return links[linkID].busyTime;
+    }
+
+    std::string printStats(SimTime_t elapsed) const;
+
+    static std::string getKindString(Kind kind);
+    static std::string getReductionString(Reduction reduction);
+
+private:
+    struct TopologyLink {
+        std::size_t from;
+        std::size_t to;
+        double psPerByte;
+        SimTime_t latency;
+        std::size_t tier = 0; // 0 is the chiplet tier
+        SimTime_t freeAt = 0;
+        uint64_t transfers = 0;
+        uint64_t bytes = 0;
+        SimTime_t busyTime = 0;
+        SimTime_t queueingDelay = 0;
+    };
+
+    std::shared_ptr<SST::Output> output;
+    Kind kind_ = Kind::Ideal;
+    std::size_t numChiplets;
+    std::size_t numNodes;
+    std::size_t meshColumns = 0;
+    std::size_t meshRows = 0;
+    std::size_t switchRadix = 0;
+    double psPerByte;    // Chiplet link bandwidth
+    SimTime_t hopLatency;
+    uint64_t packetSize = 0; // 0 sends each transfer as a single packet
+    uint64_t flitSize = 0;   // 0 forwards whole packets (store and forward)
+    bool streamingReceive = false;
+    Reduction reduction_ = Reduction::None;
+    double adderPsPerByte;
+    SimTime_t adderLatency_;
+
+    struct NodeAdder {
+        SimTime_t freeAt = 0;
+        uint64_t reductions = 0;
+        SimTime_t busyTime = 0;
+    };
+    std::vector<NodeAdder> adders; // Indexed by node
+
+    std::vector<std::size_t> groupSizes_;
+    std::vector<std::size_t> parent; // Tree topologies: the switch above each node, numNodes for the root
+
+    struct Stats {
+        uint64_t transfers = 0;
+        uint64_t packets = 0;
+        SimTime_t streamingLead = 0; // Time between consumer start and last packet arrival
+    } stats_;
+
+    std::vector<TopologyLink> links;
+    std::map<std::pair<std::size_t,std::size_t>,std::size_t> linkIndex;
+    std::vector<std::vector<std::size_t>> routes; // Indexed by src * numChiplets + dst, holds link indices
+
+    SimTime_t sendOver(const std::vector<std::size_t> & route, uint64_t size, SimTime_t now, bool stream);
+    void addLink(std::size_t a, std::size_t b, double psPerByte);
+    void addLink(std::size_t a, std::size_t b, double psPerByte, SimTime_t latency, std::size_t tier);
+    // Route up the switch tree to the common ancestor and back down
+    std::vector<std::size_t> treeRoute(std::size_t src, std::size_t dst) const;
+    std::size_t link(std::size_t from, std::size_t to) const;
+    std::vector<std::size_t> computeRoute(std::size_t src, std::size_t dst) const;
+    // Appends the links taken when moving along one ring of size n from position a to position b
+    void walkRing(std::vector<std::size_t> & route, std::size_t & node, std::size_t from, std::size_t to, std::size_t n, std::size_t stride, bool wrap) const;
+};
+
+} // Namespace Cinnamon
+} // Namespace SST
+
+#endif // _H_SST_CINNAMON_TOPOLOGY
@@ -0,0 +1,28 @@
+#ifndef _H_SST_CINNAMON_LOG
+#define _H_SST_CINNAMON_LOG
+
+#include "sst/core/output.h"
+
+// Highest verbose level compiled into the element. Calls above it are removed entirely.
+// Release builds keep the configuration messages and per-sync summaries (levels 1 and 2)
+#ifndef CINNAMON_MAX_VERBOSE
+#ifdef NDEBUG
+#define CINNAMON_MAX_VERBOSE 2
+#else
+#define CINNAMON_MAX_VERBOSE 100
+#endif
+#endif
+
+// Drop-in for output->verbose(CALL_INFO, level, mask, fmt, ...) that checks the level before
+// evaluating the arguments, so calls like instruction->getString() cost nothing when disabled.
+// level must be a constant
+#define CINNAMON_VERBOSE(out, level, mask, ...)                                     \
+    do {                                                                            \
+        if constexpr ((level) <= CINNAMON_MAX_VERBOSE) {                            \
+            if ((out)->getVerboseLevel() >= static_cast<uint32_t>(level)) {         \
+                (out)->verbose(CALL_INFO, level, mask, __VA_ARGS__);                \
+            }                                                                       \
+        }                                                                           \
+    } while (0)
+
+#endif // _H_SST_CINNAMON_LOG